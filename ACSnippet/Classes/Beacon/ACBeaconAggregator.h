@@ -0,0 +1,158 @@
+//
+//  ACBeaconAggregator.h
+//  ACSnippet
+//
+//  Created by Wenzhi WU on 19/10/2026.
+//  Copyright © 2026 Wenzhi WU. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import <CoreLocation/CoreLocation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// Number of samples kept per beacon
+#define ACBeaconSampleWindow 16
+
+/// A structure that identifies a beacon without string formatting
+///
+/// Fields:
+///    uuid:
+///        Raw 128-bit proximity UUID
+///    major:
+///        Major value
+///    minor:
+///        Minor value
+struct ACBeaconIdentity {
+    uint8_t     uuid[16];
+    uint16_t    major;
+    uint16_t    minor;
+};
+typedef struct ACBeaconIdentity ACBeaconIdentity;
+
+/// A structure that holds one ranging sample
+///
+/// Fields:
+///    identity:
+///        Beacon identity
+///    rssi:
+///        Received signal strength in decibels, 0 if unknown
+///    accuracy:
+///        Estimated distance in meters, negative if unknown
+///    timestamp:
+///        Time of sample in seconds
+struct ACBeaconSample {
+    ACBeaconIdentity    identity;
+    NSInteger           rssi;
+    CLLocationAccuracy  accuracy;
+    NSTimeInterval      timestamp;
+};
+typedef struct ACBeaconSample ACBeaconSample;
+
+/// A structure that holds smoothed state of one beacon
+///
+/// Fields:
+///    identity:
+///        Beacon identity
+///    rssi:
+///        Exponential moving average of known RSSI samples, 0 if none is known
+///    accuracy:
+///        Kalman filtered distance in meters, -1 if none is known
+///    accuracyVariance:
+///        Variance of filtered distance
+///    sampleCount:
+///        Number of samples received since beacon was first seen
+///    lastSeen:
+///        Time of latest sample in seconds
+struct ACBeaconEstimate {
+    ACBeaconIdentity    identity;
+    double              rssi;
+    double              accuracy;
+    double              accuracyVariance;
+    NSUInteger          sampleCount;
+    NSTimeInterval      lastSeen;
+};
+typedef struct ACBeaconEstimate ACBeaconEstimate;
+
+/// Make beacon identity
+/// @param uuid Proximity UUID
+/// @param major Major value
+/// @param minor Minor value
+ACBeaconIdentity ACBeaconIdentityMake(NSUUID *uuid, uint16_t major, uint16_t minor);
+
+/// Make beacon identity of ranged beacon, no string is created
+/// @param beacon Ranged beacon
+ACBeaconIdentity ACBeaconIdentityFromBeacon(CLBeacon *beacon);
+
+/// Whether two identities refer to the same beacon
+BOOL ACBeaconIdentityEqualToIdentity(ACBeaconIdentity identity, ACBeaconIdentity other);
+
+/// Make ranging sample
+ACBeaconSample ACBeaconSampleMake(ACBeaconIdentity identity, NSInteger rssi, CLLocationAccuracy accuracy, NSTimeInterval timestamp);
+
+/// Thread-safe aggregator of high-rate beacon ranging samples. Beacons are indexed by packed identity in an open
+/// addressing table, each keeps a ring buffer of latest samples with EMA smoothed RSSI and Kalman filtered distance.
+/// Ingesting does not allocate, beacons not seen within staleInterval are evicted
+@interface ACBeaconAggregator : NSObject
+
+/// Maximum number of tracked beacons, the least recently seen beacon is replaced when it is reached
+@property (nonatomic, assign, readonly) NSUInteger capacity;
+
+/// Number of tracked beacons
+@property (nonatomic, assign, readonly) NSUInteger count;
+
+/// Weight of new RSSI sample in moving average, default is 0.3
+@property (nonatomic, assign) double rssiSmoothingFactor;
+
+/// Process noise of distance filter per second, default is 0.5
+@property (nonatomic, assign) double accuracyProcessNoise;
+
+/// Measurement noise of distance filter, default is 2.0
+@property (nonatomic, assign) double accuracyMeasurementNoise;
+
+/// Beacons without sample for longer than this interval are evicted, default is 10 seconds
+@property (nonatomic, assign) NSTimeInterval staleInterval;
+
+/// Designate initializer for ACBeaconAggregator object
+/// @param capacity Maximum number of tracked beacons
+- (instancetype)initWithCapacity:(NSUInteger)capacity;
+
+/// Ingest beacons of one ranging callback
+/// @param beacons Ranged beacons
+/// @param timestamp Time of ranging in seconds
+- (void)ingestBeacons:(NSArray <CLBeacon *> *)beacons timestamp:(NSTimeInterval)timestamp;
+
+/// Ingest recorded or replayed samples, samples should be in time order
+/// @param samples Sample buffer
+/// @param count Number of samples
+- (void)ingestSamples:(const ACBeaconSample *)samples count:(NSUInteger)count;
+
+/// Get smoothed state of beacon
+/// @param estimate Estimate to fill, pass NULL to check whether beacon is tracked
+/// @param identity Beacon identity
+- (BOOL)getEstimate:(nullable ACBeaconEstimate *)estimate forIdentity:(ACBeaconIdentity)identity;
+
+/// Get smoothed state of all tracked beacons
+/// @param estimates Estimate buffer
+/// @param maxCount Size of buffer
+/// @return Number of filled estimates
+- (NSUInteger)getEstimates:(ACBeaconEstimate *)estimates maxCount:(NSUInteger)maxCount;
+
+/// Get buffered samples of beacon from oldest to latest
+/// @param samples Sample buffer
+/// @param maxCount Size of buffer, at most ACBeaconSampleWindow samples are kept
+/// @param identity Beacon identity
+/// @return Number of filled samples
+- (NSUInteger)getSamples:(ACBeaconSample *)samples maxCount:(NSUInteger)maxCount forIdentity:(ACBeaconIdentity)identity;
+
+/// Evict beacons not seen within staleInterval before timestamp
+/// @param timestamp Current time in seconds
+/// @return Number of evicted beacons
+- (NSUInteger)evictStaleBeaconsAtTimestamp:(NSTimeInterval)timestamp;
+
+/// Remove all beacons
+- (void)removeAllBeacons;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,380 @@
+//
+//  ACBeaconAggregator.m
+//  ACSnippet
+//
+//  Created by Wenzhi WU on 19/10/2026.
+//  Copyright © 2026 Wenzhi WU. All rights reserved.
+//
+
+#import "ACBeaconAggregator.h"
+#import "CLBeacon+SafeUUID.h"
+#import <pthread.h>
+
+/// Bucket value of empty bucket
+static const int32_t ACBeaconBucketEmpty = -1;
+
+/// A structure that holds state and sample ring of one tracked beacon
+///
+/// Fields:
+///    identity:
+///        Beacon identity
+///    rssi, accuracy, timestamp:
+///        Sample ring, head points to the slot of the next sample
+///    head:
+///        Next ring slot
+///    filled:
+///        Number of samples in ring
+///    rssiAverage:
+///        Moving average of known RSSI
+///    accuracyEstimate, accuracyVariance:
+///        Distance filter state, variance is negative until the first known distance
+///    sampleCount:
+///        Total samples
+///    lastSeen:
+///        Time of latest sample
+///    lastMeasured:
+///        Time of latest known distance, process noise grows from here
+///    occupied:
+///        Whether entry is in use
+struct ACBeaconEntry {
+    ACBeaconIdentity    identity;
+    int16_t             rssi[ACBeaconSampleWindow];
+    float               accuracy[ACBeaconSampleWindow];
+    NSTimeInterval      timestamp[ACBeaconSampleWindow];
+    uint8_t             head;
+    uint8_t             filled;
+    double              rssiAverage;
+    double              accuracyEstimate;
+    double              accuracyVariance;
+    NSUInteger          sampleCount;
+    NSTimeInterval      lastSeen;
+    NSTimeInterval      lastMeasured;
+    BOOL                occupied;
+};
+typedef struct ACBeaconEntry ACBeaconEntry;
+
+ACBeaconIdentity ACBeaconIdentityMake(NSUUID *uuid, uint16_t major, uint16_t minor) {
+    ACBeaconIdentity identity;
+    memset(&identity, 0, sizeof(ACBeaconIdentity));
+    [uuid getUUIDBytes:identity.uuid];
+    identity.major = major;
+    identity.minor = minor;
+    return identity;
+}
+
+ACBeaconIdentity ACBeaconIdentityFromBeacon(CLBeacon *beacon) {
+    return ACBeaconIdentityMake(beacon.safeUUID, beacon.major.unsignedShortValue, beacon.minor.unsignedShortValue);
+}
+
+BOOL ACBeaconIdentityEqualToIdentity(ACBeaconIdentity identity, ACBeaconIdentity other) {
+    return identity.major == other.major && identity.minor == other.minor && memcmp(identity.uuid, other.uuid, 16) == 0;
+}
+
+ACBeaconSample ACBeaconSampleMake(ACBeaconIdentity identity, NSInteger rssi, CLLocationAccuracy accuracy, NSTimeInterval timestamp) {
+    ACBeaconSample sample;
+    sample.identity = identity;
+    sample.rssi = rssi;
+    sample.accuracy = accuracy;
+    sample.timestamp = timestamp;
+    return sample;
+}
+
+static inline NSUInteger ACBeaconIdentityHash(const ACBeaconIdentity *identity) {
+    uint64_t high, low;
+    memcpy(&high, identity->uuid, 8);
+    memcpy(&low, identity->uuid + 8, 8);
+    uint64_t hash = high * 0x9E3779B97F4A7C15ULL;
+    hash ^= (low + 0xBF58476D1CE4E5B9ULL) * 0x94D049BB133111EBULL;
+    hash ^= ((uint64_t)identity->major << 16 | identity->minor) * 0xD6E8FEB86659FD93ULL;
+    return (NSUInteger)(hash ^ (hash >> 29));
+}
+
+@interface ACBeaconAggregator () {
+    ACBeaconEntry   *_entries;
+    int32_t         *_buckets;
+    NSUInteger      _bucketMask;
+    uint32_t        *_freeEntries;
+    NSUInteger      _freeCount;
+    NSTimeInterval  _lastSweep;
+}
+
+/// Lock for thread safe
+@property (nonatomic, assign) pthread_mutex_t lock;
+
+@end
+
+@implementation ACBeaconAggregator
+
+- (instancetype)init {
+    return [self initWithCapacity:128];
+}
+
+- (instancetype)initWithCapacity:(NSUInteger)capacity {
+    self = [super init];
+    if (self) {
+        pthread_mutex_init(&_lock, NULL);
+        _capacity = MAX(1, MIN(capacity, (NSUInteger)INT32_MAX / 4));
+        _rssiSmoothingFactor = 0.3;
+        _accuracyProcessNoise = 0.5;
+        _accuracyMeasurementNoise = 2.0;
+        _staleInterval = 10;
+        _lastSweep = -DBL_MAX;
+        
+        NSUInteger buckets = 2;
+        while (buckets < _capacity * 2) buckets <<= 1;
+        _bucketMask = buckets - 1;
+        _buckets = malloc(buckets * sizeof(int32_t));
+        _entries = calloc(_capacity, sizeof(ACBeaconEntry));
+        _freeEntries = malloc(_capacity * sizeof(uint32_t));
+        [self resetTable];
+    }
+    
+    return self;
+}
+
+- (void)dealloc {
+    free(_entries);
+    free(_buckets);
+    free(_freeEntries);
+    pthread_mutex_destroy(&_lock);
+}
+
+- (NSUInteger)count {
+    pthread_mutex_lock(&_lock);
+    NSUInteger count = _capacity - _freeCount;
+    pthread_mutex_unlock(&_lock);
+    return count;
+}
+
+- (void)ingestBeacons:(NSArray<CLBeacon *> *)beacons timestamp:(NSTimeInterval)timestamp {
+    pthread_mutex_lock(&_lock);
+    for (CLBeacon *beacon in beacons) {
+        ACBeaconSample sample = ACBeaconSampleMake(ACBeaconIdentityFromBeacon(beacon), beacon.rssi, beacon.accuracy, timestamp);
+        [self addSample:&sample];
+    }
+    [self sweepIfNeededAtTimestamp:timestamp];
+    pthread_mutex_unlock(&_lock);
+}
+
+- (void)ingestSamples:(const ACBeaconSample *)samples count:(NSUInteger)count {
+    if (!samples || count == 0) return;
+    
+    pthread_mutex_lock(&_lock);
+    for (NSUInteger i = 0; i < count; i++) {
+        [self addSample:&samples[i]];
+        [self sweepIfNeededAtTimestamp:samples[i].timestamp];
+    }
+    pthread_mutex_unlock(&_lock);
+}
+
+- (BOOL)getEstimate:(ACBeaconEstimate *)estimate forIdentity:(ACBeaconIdentity)identity {
+    pthread_mutex_lock(&_lock);
+    NSUInteger bucket = [self bucketForIdentity:&identity];
+    if (bucket != NSNotFound && estimate) {
+        [self fillEstimate:estimate withEntry:&_entries[_buckets[bucket]]];
+    }
+    pthread_mutex_unlock(&_lock);
+    return bucket != NSNotFound;
+}
+
+- (NSUInteger)getEstimates:(ACBeaconEstimate *)estimates maxCount:(NSUInteger)maxCount {
+    NSUInteger filled = 0;
+    pthread_mutex_lock(&_lock);
+    for (NSUInteger i = 0; i < _capacity && filled < maxCount; i++) {
+        if (!_entries[i].occupied) continue;
+        
+        [self fillEstimate:&estimates[filled++] withEntry:&_entries[i]];
+    }
+    pthread_mutex_unlock(&_lock);
+    return filled;
+}
+
+- (NSUInteger)getSamples:(ACBeaconSample *)samples maxCount:(NSUInteger)maxCount forIdentity:(ACBeaconIdentity)identity {
+    NSUInteger filled = 0;
+    pthread_mutex_lock(&_lock);
+    NSUInteger bucket = [self bucketForIdentity:&identity];
+    if (bucket != NSNotFound) {
+        ACBeaconEntry *entry = &_entries[_buckets[bucket]];
+        NSUInteger count = MIN(entry->filled, maxCount);
+        // skip oldest samples that do not fit
+        NSUInteger start = (entry->head + ACBeaconSampleWindow - entry->filled + (entry->filled - count)) % ACBeaconSampleWindow;
+        for (; filled < count; filled++) {
+            NSUInteger slot = (start + filled) % ACBeaconSampleWindow;
+            samples[filled] = ACBeaconSampleMake(entry->identity, entry->rssi[slot], entry->accuracy[slot], entry->timestamp[slot]);
+        }
+    }
+    pthread_mutex_unlock(&_lock);
+    return filled;
+}
+
+- (NSUInteger)evictStaleBeaconsAtTimestamp:(NSTimeInterval)timestamp {
+    pthread_mutex_lock(&_lock);
+    NSUInteger evicted = [self sweepAtTimestamp:timestamp];
+    pthread_mutex_unlock(&_lock);
+    return evicted;
+}
+
+- (void)removeAllBeacons {
+    pthread_mutex_lock(&_lock);
+    memset(_entries, 0, _capacity * sizeof(ACBeaconEntry));
+    [self resetTable];
+    pthread_mutex_unlock(&_lock);
+}
+
+#pragma mark - Entries
+/// Empty buckets and free list, lock should be held or object not shared yet
+- (void)resetTable {
+    for (NSUInteger i = 0; i <= _bucketMask; i++) {
+        _buckets[i] = ACBeaconBucketEmpty;
+    }
+    
+    // hand out low entries first
+    for (NSUInteger i = 0; i < _capacity; i++) {
+        _freeEntries[i] = (uint32_t)(_capacity - 1 - i);
+    }
+    _freeCount = _capacity;
+}
+
+/// Record sample into ring and update filters, lock should be held
+/// @param sample Ranging sample
+- (void)addSample:(const ACBeaconSample *)sample {
+    NSUInteger bucket = [self bucketForIdentity:&sample->identity];
+    ACBeaconEntry *entry = NULL;
+    if (bucket != NSNotFound) {
+        entry = &_entries[_buckets[bucket]];
+    } else {
+        if (_freeCount == 0) {
+            [self evictEntryAtIndex:[self leastRecentlySeenEntry]];
+        }
+        
+        uint32_t index = _freeEntries[--_freeCount];
+        entry = &_entries[index];
+        memset(entry, 0, sizeof(ACBeaconEntry));
+        entry->identity = sample->identity;
+        entry->accuracyEstimate = -1;
+        entry->accuracyVariance = -1;
+        entry->lastSeen = sample->timestamp;
+        entry->occupied = YES;
+        [self insertBucketForIdentity:&sample->identity entry:index];
+    }
+    
+    NSInteger rssi = MAX(INT16_MIN, MIN(INT16_MAX, sample->rssi));
+    entry->rssi[entry->head] = (int16_t)rssi;
+    entry->accuracy[entry->head] = (float)sample->accuracy;
+    entry->timestamp[entry->head] = sample->timestamp;
+    entry->head = (entry->head + 1) % ACBeaconSampleWindow;
+    entry->filled = MIN(entry->filled + 1, ACBeaconSampleWindow);
+    entry->sampleCount++;
+    
+    // 0 RSSI means ranging has no reading for this tick
+    if (rssi != 0) {
+        entry->rssiAverage = entry->rssiAverage == 0 ? rssi : entry->rssiAverage + _rssiSmoothingFactor * (rssi - entry->rssiAverage);
+    }
+    
+    if (sample->accuracy >= 0) {
+        if (entry->accuracyVariance < 0) {
+            entry->accuracyEstimate = sample->accuracy;
+            entry->accuracyVariance = _accuracyMeasurementNoise;
+        } else {
+            double elapsed = MAX(0, sample->timestamp - entry->lastMeasured);
+            double variance = entry->accuracyVariance + _accuracyProcessNoise * elapsed;
+            double gain = variance / (variance + _accuracyMeasurementNoise);
+            entry->accuracyEstimate += gain * (sample->accuracy - entry->accuracyEstimate);
+            entry->accuracyVariance = (1 - gain) * variance;
+        }
+        entry->lastMeasured = MAX(entry->lastMeasured, sample->timestamp);
+    }
+    
+    entry->lastSeen = MAX(entry->lastSeen, sample->timestamp);
+}
+
+- (void)fillEstimate:(ACBeaconEstimate *)estimate withEntry:(const ACBeaconEntry *)entry {
+    estimate->identity = entry->identity;
+    estimate->rssi = entry->rssiAverage;
+    estimate->accuracy = entry->accuracyEstimate;
+    estimate->accuracyVariance = MAX(0, entry->accuracyVariance);
+    estimate->sampleCount = entry->sampleCount;
+    estimate->lastSeen = entry->lastSeen;
+}
+
+/// Sweep at most twice per stale interval, lock should be held
+- (void)sweepIfNeededAtTimestamp:(NSTimeInterval)timestamp {
+    if (timestamp - _lastSweep < _staleInterval / 2) return;
+    
+    [self sweepAtTimestamp:timestamp];
+}
+
+/// Evict stale entries, lock should be held
+- (NSUInteger)sweepAtTimestamp:(NSTimeInterval)timestamp {
+    _lastSweep = timestamp;
+    NSUInteger evicted = 0;
+    for (NSUInteger i = 0; i < _capacity; i++) {
+        if (_entries[i].occupied && timestamp - _entries[i].lastSeen > _staleInterval) {
+            [self evictEntryAtIndex:i];
+            evicted++;
+        }
+    }
+    
+    return evicted;
+}
+
+- (NSUInteger)leastRecentlySeenEntry {
+    NSUInteger oldest = 0;
+    for (NSUInteger i = 1; i < _capacity; i++) {
+        if (_entries[i].lastSeen < _entries[oldest].lastSeen) oldest = i;
+    }
+    
+    return oldest;
+}
+
+- (void)evictEntryAtIndex:(NSUInteger)index {
+    [self removeBucketForIdentity:&_entries[index].identity];
+    _entries[index].occupied = NO;
+    _freeEntries[_freeCount++] = (uint32_t)index;
+}
+
+#pragma mark - Buckets
+/// Find bucket index for identity by linear probing, lock should be held
+- (NSUInteger)bucketForIdentity:(const ACBeaconIdentity *)identity {
+    NSUInteger index = ACBeaconIdentityHash(identity) & _bucketMask;
+    while (_buckets[index] != ACBeaconBucketEmpty) {
+        if (ACBeaconIdentityEqualToIdentity(_entries[_buckets[index]].identity, *identity)) return index;
+        index = (index + 1) & _bucketMask;
+    }
+    
+    return NSNotFound;
+}
+
+/// Insert entry into first empty bucket, lock should be held
+- (void)insertBucketForIdentity:(const ACBeaconIdentity *)identity entry:(uint32_t)entry {
+    NSUInteger index = ACBeaconIdentityHash(identity) & _bucketMask;
+    while (_buckets[index] != ACBeaconBucketEmpty) {
+        index = (index + 1) & _bucketMask;
+    }
+    
+    _buckets[index] = (int32_t)entry;
+}
+
+/// Remove identity with backward shift so probing chains stay intact without tombstones, lock should be held
+- (void)removeBucketForIdentity:(const ACBeaconIdentity *)identity {
+    NSUInteger hole = [self bucketForIdentity:identity];
+    if (hole == NSNotFound) return;
+    
+    NSUInteger index = hole;
+    while (YES) {
+        index = (index + 1) & _bucketMask;
+        if (_buckets[index] == ACBeaconBucketEmpty) break;
+        
+        // keep entry in place if its home bucket lies cyclically within (hole, index]
+        NSUInteger home = ACBeaconIdentityHash(&_entries[_buckets[index]].identity) & _bucketMask;
+        BOOL inPlace = hole <= index ? (hole < home && home <= index) : (hole < home || home <= index);
+        if (inPlace) continue;
+        
+        _buckets[hole] = _buckets[index];
+        hole = index;
+    }
+    
+    _buckets[hole] = ACBeaconBucketEmpty;
+}
+
+@end
@@ -9,6 +9,7 @@
 #import <Foundation/Foundation.h>
 #import <YYKit/YYDiskCache.h>
 #import "ACLRUCache.h"
+#import "ACCachePack.h"
 
 NS_ASSUME_NONNULL_BEGIN
 
@@ -23,6 +24,22 @@ NS_ASSUME_NONNULL_BEGIN
 /// Disk storage for cache
 @property (strong, readonly) YYDiskCache *diskCache;
 
+/// Maximum number of objects on disk, default is NSUIntegerMax for no limit
+@property (nonatomic, assign) NSUInteger diskCountLimit;
+
+/// Maximum total bytes of objects on disk, default is NSUIntegerMax for no limit
+@property (nonatomic, assign) NSUInteger diskCostLimit;
+
+/// Seconds of last access credited for each priority class when choosing disk objects to evict, default is one day,
+/// e.g. an object of priority 2 is kept over a priority 0 object accessed up to two days later
+@property (nonatomic, assign) NSTimeInterval diskPriorityAllowance;
+
+/// Number of objects removed from disk per eviction batch, default is 32
+@property (nonatomic, assign) NSUInteger diskEvictionBatchSize;
+
+/// Attached read-only packs, looked up after disk cache in attach order
+@property (copy, readonly) NSArray <ACCachePack *> *packs;
+
 /// Initialize ACCache object with unique name, file path will be auto-generated
 /// @param name Name of cache storage
 - (nullable instancetype)initWithName:(NSString *)name NS_DESIGNATED_INITIALIZER;
@@ -49,6 +66,12 @@ NS_ASSUME_NONNULL_BEGIN
 /// @param key Key for object
 - (void)setObject:(id <NSCoding>)object forKey:(NSString *)key;
 
+/// Store object in cache with a given key and eviction priority class, objects with higher priority stay longer on disk
+/// @param object Cache target object
+/// @param key Key for object
+/// @param priority Priority class, e.g. tile zoom level or object type, default is 0
+- (void)setObject:(id <NSCoding>)object forKey:(NSString *)key priority:(NSInteger)priority;
+
 /// Store object in cache with a given key with completion block
 /// @param object Cache target object
 /// @param key Key for object
@@ -77,6 +100,16 @@ NS_ASSUME_NONNULL_BEGIN
 - (void)removeAllObjectsWithProgressBlock:(void(^)(int removedCount, int totalCount))progress
                                  endBlock:(void(^)(BOOL error))end;
 
+/// Attach offline pack as read-only tier after disk cache, objects set later for the same key take precedence.
+/// Removing or evicting an object also hides its pack entry until the key is set again, so a stale pack version
+/// never comes back; hidden keys are kept in memory, and removeAllObjects hides pack entries of every removed key too
+/// @param pack Offline pack
+- (void)attachPack:(ACCachePack *)pack;
+
+/// Detach offline pack
+/// @param pack Offline pack
+- (void)detachPack:(ACCachePack *)pack;
+
 
 @end
 
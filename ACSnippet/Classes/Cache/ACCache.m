@@ -7,6 +7,35 @@
 //
 
 #import "ACCache.h"
+#import "ACCacheDiskIndex.h"
+
+/// File name of disk index in cache directory
+static NSString *const ACCacheDiskIndexFileName = @"ac_disk_index.plist";
+
+/// Seconds writes are folded into one disk limit check, disk totals are database queries
+static const NSTimeInterval ACCacheDiskEvictionCheckDelay = 1;
+
+@interface ACCache ()
+
+/// Priority and last access of disk cached keys
+@property (nonatomic, strong) ACCacheDiskIndex *diskIndex;
+
+/// Serial queue of disk eviction
+@property (nonatomic, strong) dispatch_queue_t evictionQueue;
+
+/// Whether eviction is running, only accessed in eviction queue
+@property (nonatomic, assign) BOOL evicting;
+
+/// Whether a disk limit check is scheduled, a check racing on it only runs once more
+@property (atomic, assign) BOOL evictionCheckScheduled;
+
+/// Attached packs, replaced as a whole so readers need no lock
+@property (copy) NSArray <ACCachePack *> *packs;
+
+/// Keys removed or evicted from cache whose pack entries are hidden, guarded by itself
+@property (nonatomic, strong) NSMutableSet <NSString *> *hiddenPackKeys;
+
+@end
 
 @implementation ACCache
 
@@ -35,13 +64,21 @@
         _name = name;
         _diskCache = diskCache;
         _memoryCache = memoryCache;
+        _diskIndex = [[ACCacheDiskIndex alloc] initWithPath:[path stringByAppendingPathComponent:ACCacheDiskIndexFileName]];
+        _evictionQueue = dispatch_queue_create("com.mrcrow.aicity.cache.disk.eviction", dispatch_queue_attr_make_with_qos_class(DISPATCH_QUEUE_SERIAL, QOS_CLASS_UTILITY, 0));
+        _diskCountLimit = NSUIntegerMax;
+        _diskCostLimit = NSUIntegerMax;
+        _diskPriorityAllowance = 24 * 60 * 60;
+        _diskEvictionBatchSize = 32;
+        _packs = @[];
+        _hiddenPackKeys = [NSMutableSet set];
     }
     
     return self;
 }
 
 - (BOOL)containsObjectForKey:(NSString *)key {
-    return [_memoryCache containsObjectForKey:key] || [_diskCache containsObjectForKey:key];
+    return [_memoryCache containsObjectForKey:key] || [_diskCache containsObjectForKey:key] || [self packContainingKey:key];
 }
 
 - (void)containsObjectForKey:(NSString *)key withBlock:(void (^)(NSString *key, BOOL contains))block {
@@ -52,7 +89,11 @@
             block(key, YES);
         });
     } else {
-        [_diskCache containsObjectForKey:key withBlock:block];
+        __weak typeof(self) _self = self;
+        [_diskCache containsObjectForKey:key withBlock:^(NSString *key, BOOL contains) {
+            __strong typeof(_self) self = _self;
+            block(key, contains || [self packContainingKey:key]);
+        }];
     }
 }
 
@@ -62,8 +103,15 @@
         object = [_diskCache objectForKey:key];
         if (object) {
             [_memoryCache setObject:object forKey:key];
+            [_diskIndex touchKey:key];
+        } else {
+            object = [self packObjectForKey:key];
         }
+    } else {
+        // memory copy may outlive its disk object or come from a pack
+        [_diskIndex touchKeyIfIndexed:key];
     }
+    
     return object;
 }
 
@@ -71,6 +119,7 @@
     if (!block) return;
     id <NSCoding> object = [_memoryCache objectForKey:key];
     if (object) {
+        [_diskIndex touchKeyIfIndexed:key];
         dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
             block(key, object);
         });
@@ -81,6 +130,11 @@
             if (object && ![self.memoryCache objectForKey:key]) {
                 [self.memoryCache setObject:object forKey:key];
             }
+            if (object) {
+                [self.diskIndex touchKey:key];
+            } else {
+                object = [self packObjectForKey:key];
+            }
             block(key, object);
         }];
     }
@@ -88,39 +142,241 @@
 
 - (void)setObject:(id<NSCoding>)object forKey:(NSString *)key {
     [_memoryCache setObject:object forKey:key];
+    // index is touched before disk write, so eviction running meanwhile skips the key
+    [_diskIndex touchKey:key];
     [_diskCache setObject:object forKey:key];
+    [self revealPackKeys:@[key]];
+    [self setNeedsDiskEviction];
+}
+
+- (void)setObject:(id<NSCoding>)object forKey:(NSString *)key priority:(NSInteger)priority {
+    [_memoryCache setObject:object forKey:key];
+    [_diskIndex setPriority:priority forKey:key];
+    [_diskCache setObject:object forKey:key];
+    [self revealPackKeys:@[key]];
+    [self setNeedsDiskEviction];
 }
 
 - (void)setObject:(id<NSCoding>)object forKey:(NSString *)key withBlock:(void (^)(void))block {
     [_memoryCache setObject:object forKey:key];
+    [_diskIndex touchKey:key];
     [_diskCache setObject:object forKey:key withBlock:block];
+    [self revealPackKeys:@[key]];
+    [self setNeedsDiskEviction];
 }
 
 - (void)removeObjectForKey:(NSString *)key {
     [_memoryCache removeObjectForKey:key];
     [_diskCache removeObjectForKey:key];
+    [_diskIndex removeKey:key];
+    [self hidePackKeys:@[key]];
 }
 
 - (void)removeObjectForKey:(NSString *)key withBlock:(void (^)(NSString *key))block {
     [_memoryCache removeObjectForKey:key];
     [_diskCache removeObjectForKey:key withBlock:block];
+    [_diskIndex removeKey:key];
+    [self hidePackKeys:@[key]];
 }
 
 - (void)removeAllObjects {
+    [self hidePackKeys:[_diskIndex allKeys]];
     [_memoryCache removeAllObjects];
     [_diskCache removeAllObjects];
+    [_diskIndex removeAllKeys];
+    [_diskIndex setNeedsSave];
 }
 
 - (void)removeAllObjectsWithBlock:(void(^)(void))block {
+    [self hidePackKeys:[_diskIndex allKeys]];
     [_memoryCache removeAllObjects];
     [_diskCache removeAllObjectsWithBlock:block];
+    [_diskIndex removeAllKeys];
+    [_diskIndex setNeedsSave];
 }
 
 - (void)removeAllObjectsWithProgressBlock:(void(^)(int removedCount, int totalCount))progress
                                  endBlock:(void(^)(BOOL error))end {
+    [self hidePackKeys:[_diskIndex allKeys]];
     [_memoryCache removeAllObjects];
     [_diskCache removeAllObjectsWithProgressBlock:progress endBlock:end];
+    [_diskIndex removeAllKeys];
+    [_diskIndex setNeedsSave];
+}
+
+#pragma mark - Pack
+- (void)attachPack:(ACCachePack *)pack {
+    if (!pack) return;
+    
+    @synchronized (self) {
+        if ([self.packs containsObject:pack]) return;
+        self.packs = [(self.packs ?: @[]) arrayByAddingObject:pack];
+    }
+}
+
+- (void)detachPack:(ACCachePack *)pack {
+    @synchronized (self) {
+        NSMutableArray *packs = self.packs.mutableCopy;
+        [packs removeObject:pack];
+        self.packs = packs.copy;
+    }
+}
+
+/// Hide pack entries of keys that are attached
+- (void)hidePackKeys:(NSArray <NSString *> *)keys {
+    NSArray *packs = self.packs;
+    if (![packs count]) return;
+    
+    @synchronized (_hiddenPackKeys) {
+        for (NSString *key in keys) {
+            for (ACCachePack *pack in packs) {
+                if (![pack containsKey:key]) continue;
+                
+                [_hiddenPackKeys addObject:key];
+                break;
+            }
+        }
+    }
+}
+
+/// Show pack entries of keys again
+- (void)revealPackKeys:(NSArray <NSString *> *)keys {
+    @synchronized (_hiddenPackKeys) {
+        if (![_hiddenPackKeys count]) return;
+        
+        for (NSString *key in keys) {
+            [_hiddenPackKeys removeObject:key];
+        }
+    }
+}
+
+/// First attached pack containing key, nil if key is hidden
+- (ACCachePack *)packContainingKey:(NSString *)key {
+    NSArray *packs = self.packs;
+    if (![packs count]) return nil;
+    
+    @synchronized (_hiddenPackKeys) {
+        if ([_hiddenPackKeys containsObject:key]) return nil;
+    }
+    
+    for (ACCachePack *pack in packs) {
+        if ([pack containsKey:key]) return pack;
+    }
     
+    return nil;
+}
+
+/// Unarchive object from pack and keep it in memory cache, pack objects do not enter disk cache or its quota
+- (id<NSCoding>)packObjectForKey:(NSString *)key {
+    id <NSCoding> object = [[self packContainingKey:key] objectForKey:key];
+    if (object) {
+        [_memoryCache setObject:object forKey:key];
+    }
+    
+    return object;
+}
+
+#pragma mark - Disk Quota
+- (void)setDiskCountLimit:(NSUInteger)diskCountLimit {
+    _diskCountLimit = diskCountLimit;
+    [self setNeedsDiskEviction];
+}
+
+- (void)setDiskCostLimit:(NSUInteger)diskCostLimit {
+    _diskCostLimit = diskCostLimit;
+    [self setNeedsDiskEviction];
+}
+
+/// Check disk limits shortly in background and start eviction if no eviction is running, writes within
+/// ACCacheDiskEvictionCheckDelay share one check
+- (void)setNeedsDiskEviction {
+    [_diskIndex setNeedsSave];
+    if (_diskCountLimit == NSUIntegerMax && _diskCostLimit == NSUIntegerMax) return;
+    if (self.evictionCheckScheduled) return;
+    
+    self.evictionCheckScheduled = YES;
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(ACCacheDiskEvictionCheckDelay * NSEC_PER_SEC)), _evictionQueue, ^{
+        self.evictionCheckScheduled = NO;
+        if (self.evicting) return;
+        
+        self.evicting = YES;
+        [self evictDiskBatchWithKeys:nil position:0 snapshot:0 skipped:0];
+    });
+}
+
+/// Remove one batch of lowest scored keys and schedule next batch while disk is over limits. Objects stored without
+/// index go first, then keys accessed after the order was taken are skipped and a fresh order is taken once the list
+/// runs out, YYDiskCache trim only takes over when no indexed key is left. Runs in eviction queue
+/// @param keys Keys in eviction order, nil to load from index
+/// @param position Position of next batch
+/// @param snapshot Time interval since 1970 when keys were ordered
+/// @param skipped Number of keys skipped as accessed after snapshot
+- (void)evictDiskBatchWithKeys:(NSArray <NSString *> *)keys position:(NSUInteger)position snapshot:(NSTimeInterval)snapshot skipped:(NSUInteger)skipped {
+    NSUInteger countLimit = _diskCountLimit;
+    NSUInteger costLimit = _diskCostLimit;
+    NSUInteger totalCount = (NSUInteger)[_diskCache totalCount];
+    BOOL overCount = countLimit != NSUIntegerMax && totalCount > countLimit;
+    BOOL overCost = costLimit != NSUIntegerMax && (NSUInteger)[_diskCache totalCost] > costLimit;
+    if (!overCount && !overCost) {
+        self.evicting = NO;
+        return;
+    }
+    
+    if (!keys) {
+        NSUInteger indexedCount = _diskIndex.count;
+        NSUInteger count = MIN(totalCount > indexedCount ? totalCount - indexedCount : 0, MAX(1, _diskEvictionBatchSize));
+        if (overCount && !overCost) count = MIN(count, totalCount - countLimit);
+        if (count > 0 && [self evictUnindexedDiskObjects:count totalCount:totalCount]) {
+            dispatch_async(_evictionQueue, ^{
+                [self evictDiskBatchWithKeys:nil position:0 snapshot:0 skipped:0];
+            });
+            return;
+        }
+        
+        snapshot = [[NSDate date] timeIntervalSince1970];
+        skipped = 0;
+        keys = [_diskIndex keysInEvictionOrderWithPriorityAllowance:_diskPriorityAllowance];
+    }
+    
+    if (position >= keys.count) {
+        if (skipped > 0) {
+            dispatch_async(_evictionQueue, ^{
+                [self evictDiskBatchWithKeys:nil position:0 snapshot:0 skipped:0];
+            });
+            return;
+        }
+        
+        if (overCount) [_diskCache trimToCount:countLimit];
+        if (overCost) [_diskCache trimToCost:costLimit];
+        self.evicting = NO;
+        return;
+    }
+    
+    NSUInteger end = MIN(position + MAX(1, _diskEvictionBatchSize), keys.count);
+    NSArray <NSString *> *candidates = [keys subarrayWithRange:NSMakeRange(position, end - position)];
+    // each key is checked and removed under index lock, a write touching it meanwhile keeps it
+    NSArray <NSString *> *batch = [_diskIndex removeKeys:candidates notAccessedAfter:snapshot usingBlock:^(NSString *key) {
+        [self.diskCache removeObjectForKey:key];
+        [self hidePackKeys:@[key]];
+    }];
+    skipped += candidates.count - batch.count;
+    [_diskIndex setNeedsSave];
+    
+    // yield between batches so queued disk reads are not held up
+    dispatch_async(_evictionQueue, ^{
+        [self evictDiskBatchWithKeys:keys position:end snapshot:snapshot skipped:skipped];
+    });
+}
+
+/// Remove objects stored without index, e.g. before disk quota existed. Their keys are only known to YYDiskCache,
+/// so they take the lowest score and go in its access order, as they were not read since the index exists they are
+/// its least recently used. Runs in eviction queue
+/// @param count Number of objects to remove
+/// @param totalCount Number of disk objects
+/// @return Whether any object was removed
+- (BOOL)evictUnindexedDiskObjects:(NSUInteger)count totalCount:(NSUInteger)totalCount {
+    [_diskCache trimToCount:totalCount - count];
+    return (NSUInteger)[_diskCache totalCount] < totalCount;
 }
 
 - (NSString *)description {
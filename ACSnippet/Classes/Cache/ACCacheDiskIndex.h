@@ -0,0 +1,67 @@
+//
+//  ACCacheDiskIndex.h
+//  ACSnippet
+//
+//  Created by Wenzhi WU on 19/10/2026.
+//  Copyright © 2026 Wenzhi WU. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// Thread-safe index of priority and last access time of disk cached keys, persisted as property list
+@interface ACCacheDiskIndex : NSObject
+
+/// Number of indexed keys
+@property (nonatomic, assign, readonly) NSUInteger count;
+
+/// Designate initializer for ACCacheDiskIndex object, saved index is loaded from path
+/// @param path File path of index
+- (instancetype)initWithPath:(NSString *)path;
+
+/// Index key with priority and mark it accessed
+/// @param priority Priority class
+/// @param key Key for object
+- (void)setPriority:(NSInteger)priority forKey:(NSString *)key;
+
+/// Index key with default priority if it is not indexed yet, and mark it accessed, access times are saved with next coalesced save
+/// @param key Key for object
+- (void)touchKey:(NSString *)key;
+
+/// Mark key accessed only if it is indexed, e.g. for a memory cache hit whose disk object may be gone
+/// @param key Key for object
+- (void)touchKeyIfIndexed:(NSString *)key;
+
+/// Remove keys still indexed and not accessed after time, block runs for each of them while the lock is held,
+/// so a write that touches its key before storing the object is never undone by the removal
+/// @param keys Keys for objects
+/// @param time Time interval since 1970
+/// @param block Removal of the object for key
+/// @return Removed keys in input order
+- (NSArray <NSString *> *)removeKeys:(NSArray <NSString *> *)keys notAccessedAfter:(NSTimeInterval)time usingBlock:(void (^)(NSString *key))block;
+
+/// Remove key from index
+/// @param key Key for object
+- (void)removeKey:(NSString *)key;
+
+/// Remove keys from index
+/// @param keys Keys for objects
+- (void)removeKeys:(NSArray <NSString *> *)keys;
+
+/// Remove all keys from index
+- (void)removeAllKeys;
+
+/// All indexed keys
+- (NSArray <NSString *> *)allKeys;
+
+/// Keys ordered by eviction score from lowest, score is last access time plus priority times allowance
+/// @param allowance Seconds of access time credited for each priority class
+- (NSArray <NSString *> *)keysInEvictionOrderWithPriorityAllowance:(NSTimeInterval)allowance;
+
+/// Write index to file in background, repeated calls within a short time are written once
+- (void)setNeedsSave;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,248 @@
+//
+//  ACCacheDiskIndex.m
+//  ACSnippet
+//
+//  Created by Wenzhi WU on 19/10/2026.
+//  Copyright © 2026 Wenzhi WU. All rights reserved.
+//
+
+#import "ACCacheDiskIndex.h"
+#import <pthread.h>
+
+/// Delay of coalesced index saving
+#define INDEX_SAVE_DELAY 5
+
+/// Current time interval since 1970
+static inline NSTimeInterval ACCacheDiskIndexCurrentTime(void) {
+    return CFAbsoluteTimeGetCurrent() + kCFAbsoluteTimeIntervalSince1970;
+}
+
+@interface ACCacheDiskIndexEntry : NSObject
+
+/// Priority class
+@property (nonatomic, assign) NSInteger priority;
+
+/// Last access time interval since 1970
+@property (nonatomic, assign) NSTimeInterval lastAccess;
+
+@end
+
+@implementation ACCacheDiskIndexEntry
+@end
+
+
+@interface ACCacheDiskIndex ()
+
+/// File path of index
+@property (nonatomic, copy) NSString    *path;
+
+/// Lock for thread safe
+@property (nonatomic, assign) pthread_mutex_t lock;
+
+/// Key to entry storage
+@property (nonatomic, strong) NSMutableDictionary <NSString *, ACCacheDiskIndexEntry *> *entries;
+
+/// Dispatch queue for saving
+@property (nonatomic, strong) dispatch_queue_t queue;
+
+/// Whether a save is scheduled
+@property (nonatomic, assign) BOOL saveScheduled;
+
+@end
+
+@implementation ACCacheDiskIndex
+
+- (instancetype)initWithPath:(NSString *)path {
+    self = [super init];
+    if (self) {
+        pthread_mutex_init(&_lock, NULL);
+        _path = path.copy;
+        _entries = @{}.mutableCopy;
+        _queue = dispatch_queue_create("com.mrcrow.aicity.cache.disk.index", DISPATCH_QUEUE_SERIAL);
+        [self load];
+    }
+    
+    return self;
+}
+
+- (void)dealloc {
+    pthread_mutex_destroy(&_lock);
+}
+
+- (NSUInteger)count {
+    pthread_mutex_lock(&_lock);
+    NSUInteger count = _entries.count;
+    pthread_mutex_unlock(&_lock);
+    return count;
+}
+
+- (void)setPriority:(NSInteger)priority forKey:(NSString *)key {
+    if (!key) return;
+    
+    pthread_mutex_lock(&_lock);
+    ACCacheDiskIndexEntry *entry = [self entryForKey:key];
+    entry.priority = priority;
+    pthread_mutex_unlock(&_lock);
+}
+
+- (void)touchKey:(NSString *)key {
+    if (!key) return;
+    
+    pthread_mutex_lock(&_lock);
+    [self entryForKey:key];
+    pthread_mutex_unlock(&_lock);
+    [self setNeedsSave];
+}
+
+- (void)touchKeyIfIndexed:(NSString *)key {
+    if (!key) return;
+    
+    pthread_mutex_lock(&_lock);
+    ACCacheDiskIndexEntry *entry = _entries[key];
+    entry.lastAccess = ACCacheDiskIndexCurrentTime();
+    pthread_mutex_unlock(&_lock);
+    if (entry) [self setNeedsSave];
+}
+
+- (NSArray<NSString *> *)removeKeys:(NSArray<NSString *> *)keys notAccessedAfter:(NSTimeInterval)time usingBlock:(void (^)(NSString *))block {
+    NSMutableArray *removed = [NSMutableArray arrayWithCapacity:keys.count];
+    for (NSString *key in keys) {
+        // locked per key, so readers touching other keys wait for one removal at most
+        pthread_mutex_lock(&_lock);
+        ACCacheDiskIndexEntry *entry = _entries[key];
+        if (entry && entry.lastAccess <= time) {
+            if (block) block(key);
+            [_entries removeObjectForKey:key];
+            [removed addObject:key];
+        }
+        pthread_mutex_unlock(&_lock);
+    }
+    
+    return removed.copy;
+}
+
+- (void)removeKey:(NSString *)key {
+    if (!key) return;
+    
+    pthread_mutex_lock(&_lock);
+    [_entries removeObjectForKey:key];
+    pthread_mutex_unlock(&_lock);
+}
+
+- (void)removeKeys:(NSArray<NSString *> *)keys {
+    pthread_mutex_lock(&_lock);
+    [_entries removeObjectsForKeys:keys];
+    pthread_mutex_unlock(&_lock);
+}
+
+- (void)removeAllKeys {
+    pthread_mutex_lock(&_lock);
+    [_entries removeAllObjects];
+    pthread_mutex_unlock(&_lock);
+}
+
+- (NSArray<NSString *> *)allKeys {
+    pthread_mutex_lock(&_lock);
+    NSArray *keys = _entries.allKeys;
+    pthread_mutex_unlock(&_lock);
+    return keys;
+}
+
+- (NSArray<NSString *> *)keysInEvictionOrderWithPriorityAllowance:(NSTimeInterval)allowance {
+    pthread_mutex_lock(&_lock);
+    NSUInteger count = _entries.count;
+    NSString * __unsafe_unretained *keys = (NSString * __unsafe_unretained *)malloc(count * sizeof(id));
+    double *scores = malloc(count * sizeof(double));
+    NSUInteger index = 0;
+    for (NSString *key in _entries) {
+        ACCacheDiskIndexEntry *entry = _entries[key];
+        keys[index] = key;
+        scores[index] = entry.lastAccess + entry.priority * allowance;
+        index++;
+    }
+    
+    NSUInteger *order = malloc(count * sizeof(NSUInteger));
+    for (NSUInteger i = 0; i < count; i++) order[i] = i;
+    qsort_b(order, count, sizeof(NSUInteger), ^int(const void *lh, const void *rh) {
+        double left = scores[*(const NSUInteger *)lh];
+        double right = scores[*(const NSUInteger *)rh];
+        return left < right ? -1 : (left > right ? 1 : 0);
+    });
+    
+    NSMutableArray *ordered = [NSMutableArray arrayWithCapacity:count];
+    for (NSUInteger i = 0; i < count; i++) {
+        [ordered addObject:keys[order[i]]];
+    }
+    pthread_mutex_unlock(&_lock);
+    
+    free(keys);
+    free(scores);
+    free(order);
+    return ordered.copy;
+}
+
+- (void)setNeedsSave {
+    pthread_mutex_lock(&_lock);
+    BOOL scheduled = _saveScheduled;
+    _saveScheduled = YES;
+    pthread_mutex_unlock(&_lock);
+    if (scheduled) return;
+    
+    __weak typeof(self) _self = self;
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(INDEX_SAVE_DELAY * NSEC_PER_SEC)), _queue, ^{
+        __strong typeof(_self) self = _self;
+        [self save];
+    });
+}
+
+#pragma mark - Private
+/// Get entry for key, create one with default priority if not indexed, lock should be held
+/// @param key Key for object
+- (ACCacheDiskIndexEntry *)entryForKey:(NSString *)key {
+    ACCacheDiskIndexEntry *entry = _entries[key];
+    if (!entry) {
+        entry = [ACCacheDiskIndexEntry new];
+        [_entries setObject:entry forKey:key];
+    }
+    
+    entry.lastAccess = ACCacheDiskIndexCurrentTime();
+    return entry;
+}
+
+- (void)load {
+    NSData *data = [NSData dataWithContentsOfFile:_path];
+    if (!data) return;
+    
+    NSDictionary *plist = [NSPropertyListSerialization propertyListWithData:data options:NSPropertyListImmutable format:NULL error:nil];
+    if (![plist isKindOfClass:[NSDictionary class]]) {
+        NSLog(@"ACCacheDiskIndex: failed to load index at %@", _path);
+        return;
+    }
+    
+    [plist enumerateKeysAndObjectsUsingBlock:^(NSString *key, NSArray *value, BOOL *stop) {
+        if (![value isKindOfClass:[NSArray class]] || value.count < 2) return;
+        
+        ACCacheDiskIndexEntry *entry = [ACCacheDiskIndexEntry new];
+        entry.priority = [value[0] integerValue];
+        entry.lastAccess = [value[1] doubleValue];
+        [self.entries setObject:entry forKey:key];
+    }];
+}
+
+- (void)save {
+    pthread_mutex_lock(&_lock);
+    _saveScheduled = NO;
+    NSMutableDictionary *plist = [NSMutableDictionary dictionaryWithCapacity:_entries.count];
+    [_entries enumerateKeysAndObjectsUsingBlock:^(NSString *key, ACCacheDiskIndexEntry *entry, BOOL *stop) {
+        plist[key] = @[@(entry.priority), @(entry.lastAccess)];
+    }];
+    pthread_mutex_unlock(&_lock);
+    
+    NSError *error = nil;
+    NSData *data = [NSPropertyListSerialization dataWithPropertyList:plist format:NSPropertyListBinaryFormat_v1_0 options:0 error:&error];
+    if (!data || ![data writeToFile:_path options:NSDataWritingAtomic error:&error]) {
+        NSLog(@"ACCacheDiskIndex: failed to save index %@", error);
+    }
+}
+
+@end
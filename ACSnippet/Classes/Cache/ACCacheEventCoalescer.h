@@ -0,0 +1,84 @@
+//
+//  ACCacheEventCoalescer.h
+//  ACSnippet
+//
+//  Created by Wenzhi WU on 19/10/2026.
+//  Copyright © 2026 Wenzhi WU. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import "ACCacheObject.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// Change set of events folded by ACCacheEventCoalescer, keys are unique within each list and kept in first event order.
+/// A later success cancels the pending failure of the same key and a later update cancels its pending trim,
+/// trims and failures never cancel a pending update or retry since the stored object stays valid
+@interface ACCacheEventBatch : NSObject
+
+/// Keys of updated objects
+@property (nonatomic, copy, readonly) NSArray <NSString *> *updatedKeys;
+
+/// Keys of objects trimmed from memory cache
+@property (nonatomic, copy, readonly) NSArray <NSString *> *trimmedKeys;
+
+/// Keys failed to download grouped by error, keys later downloaded by retry are left out
+@property (nonatomic, copy, readonly) NSDictionary <NSError *, NSArray <NSString *> *> *failedKeys;
+
+/// Objects downloaded by retry, the latest object of each key
+@property (nonatomic, copy, readonly) NSArray <id <ACCacheObject>> *retryObjects;
+
+/// Number of events folded into batch
+@property (nonatomic, assign, readonly) NSUInteger eventCount;
+
+@end
+
+/// Thread-safe accumulator of cache events that delivers them in batches on main queue, at most once per interval
+@interface ACCacheEventCoalescer : NSObject
+
+/// Minimum time between two deliveries, default is 1/60 second for one batch per display frame
+@property (atomic, assign) NSTimeInterval interval;
+
+/// Number of events received
+@property (atomic, assign, readonly) NSUInteger receivedEventCount;
+
+/// Number of batches delivered
+@property (atomic, assign, readonly) NSUInteger deliveredBatchCount;
+
+/// Number of events folded into a batch with earlier events, i.e. deliveries saved
+@property (atomic, assign, readonly) NSUInteger foldedEventCount;
+
+/// Number of keys dropped because they were already pending in the same list
+@property (atomic, assign, readonly) NSUInteger duplicateKeyCount;
+
+/// Number of pending failed or trimmed keys dropped because a later success superseded them
+@property (atomic, assign, readonly) NSUInteger cancelledKeyCount;
+
+/// Designate initializer for ACCacheEventCoalescer object
+/// @param interval Minimum time between two deliveries
+/// @param handler Delivery handler, called on main queue
+- (instancetype)initWithInterval:(NSTimeInterval)interval deliveryHandler:(void (^)(ACCacheEventBatch *batch))handler;
+
+/// Add update event
+/// @param keys Keys of updated objects
+- (void)addUpdatedKeys:(NSArray <NSString *> *)keys;
+
+/// Add memory trim event
+/// @param keys Keys of trimmed objects
+- (void)addTrimmedKeys:(NSArray <NSString *> *)keys;
+
+/// Add download failure event
+/// @param keys Keys failed to download
+/// @param error Download error
+- (void)addFailedKeys:(NSArray <NSString *> *)keys withError:(NSError *)error;
+
+/// Add retry download event
+/// @param objects Objects downloaded by retry
+- (void)addRetryObjects:(NSArray <id <ACCacheObject>> *)objects;
+
+/// Deliver pending events without waiting for interval
+- (void)flush;
+
+@end
+
+NS_ASSUME_NONNULL_END
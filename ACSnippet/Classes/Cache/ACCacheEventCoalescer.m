@@ -0,0 +1,246 @@
+//
+//  ACCacheEventCoalescer.m
+//  ACSnippet
+//
+//  Created by Wenzhi WU on 19/10/2026.
+//  Copyright © 2026 Wenzhi WU. All rights reserved.
+//
+
+#import "ACCacheEventCoalescer.h"
+#import <QuartzCore/QuartzCore.h>
+
+#pragma mark - ACCacheEventBatch
+
+@interface ACCacheEventBatch ()
+@property (nonatomic, copy) NSArray <NSString *> *updatedKeys;
+@property (nonatomic, copy) NSArray <NSString *> *trimmedKeys;
+@property (nonatomic, copy) NSDictionary <NSError *, NSArray <NSString *> *> *failedKeys;
+@property (nonatomic, copy) NSArray <id <ACCacheObject>> *retryObjects;
+@property (nonatomic, assign) NSUInteger eventCount;
+@end
+
+@implementation ACCacheEventBatch
+
+- (NSString *)description {
+    return [NSString stringWithFormat:@"<%@: %p> (%lu events, %lu updated, %lu trimmed, %lu failed groups, %lu retried)", self.class, self,
+            (unsigned long)_eventCount, (unsigned long)_updatedKeys.count, (unsigned long)_trimmedKeys.count,
+            (unsigned long)_failedKeys.count, (unsigned long)_retryObjects.count];
+}
+
+@end
+
+#pragma mark - ACCacheEventCoalescer
+
+@interface ACCacheEventCoalescer ()
+
+/// Serial queue owning pending events
+@property (nonatomic, strong) dispatch_queue_t queue;
+
+/// Delivery handler
+@property (nonatomic, copy) void (^handler)(ACCacheEventBatch *batch);
+
+/// Pending updated keys
+@property (nonatomic, strong) NSMutableOrderedSet <NSString *> *updatedKeys;
+
+/// Pending trimmed keys
+@property (nonatomic, strong) NSMutableOrderedSet <NSString *> *trimmedKeys;
+
+/// Pending failed keys by error
+@property (nonatomic, strong) NSMutableDictionary <NSError *, NSMutableOrderedSet <NSString *> *> *failedKeys;
+
+/// Pending retry object IDs in first event order
+@property (nonatomic, strong) NSMutableOrderedSet <NSString *> *retryKeys;
+
+/// Pending retry objects by object ID
+@property (nonatomic, strong) NSMutableDictionary <NSString *, id <ACCacheObject>> *retryObjects;
+
+/// Number of pending events
+@property (nonatomic, assign) NSUInteger pendingEventCount;
+
+/// Media time of last delivery
+@property (nonatomic, assign) CFTimeInterval lastDelivery;
+
+/// Whether a delivery is scheduled
+@property (nonatomic, assign) BOOL scheduled;
+
+/// Incremented by each delivery, so a scheduled delivery overtaken by flush is skipped
+@property (nonatomic, assign) NSUInteger generation;
+
+@property (atomic, assign) NSUInteger receivedEventCount;
+@property (atomic, assign) NSUInteger deliveredBatchCount;
+@property (atomic, assign) NSUInteger foldedEventCount;
+@property (atomic, assign) NSUInteger duplicateKeyCount;
+@property (atomic, assign) NSUInteger cancelledKeyCount;
+
+@end
+
+@implementation ACCacheEventCoalescer
+
+- (instancetype)init {
+    return [self initWithInterval:1.0 / 60 deliveryHandler:^(ACCacheEventBatch *batch) {}];
+}
+
+- (instancetype)initWithInterval:(NSTimeInterval)interval deliveryHandler:(void (^)(ACCacheEventBatch *))handler {
+    self = [super init];
+    if (self) {
+        _interval = interval;
+        _handler = [handler copy];
+        _queue = dispatch_queue_create("com.mrcrow.aicity.cache.manager.events", DISPATCH_QUEUE_SERIAL);
+        _updatedKeys = [NSMutableOrderedSet orderedSet];
+        _trimmedKeys = [NSMutableOrderedSet orderedSet];
+        _failedKeys = @{}.mutableCopy;
+        _retryKeys = [NSMutableOrderedSet orderedSet];
+        _retryObjects = @{}.mutableCopy;
+        _lastDelivery = -DBL_MAX;
+    }
+
+    return self;
+}
+
+#pragma mark - Events
+- (void)addUpdatedKeys:(NSArray<NSString *> *)keys {
+    if (![keys count]) return;
+
+    NSArray *copied = keys.copy;
+    dispatch_async(_queue, ^{
+        [self cancelKeys:copied inSet:self.trimmedKeys];
+        [self cancelFailedKeys:copied];
+        [self addKeys:copied toSet:self.updatedKeys];
+        [self didAddEvent];
+    });
+}
+
+- (void)addTrimmedKeys:(NSArray<NSString *> *)keys {
+    if (![keys count]) return;
+
+    NSArray *copied = keys.copy;
+    dispatch_async(_queue, ^{
+        [self addKeys:copied toSet:self.trimmedKeys];
+        [self didAddEvent];
+    });
+}
+
+- (void)addFailedKeys:(NSArray<NSString *> *)keys withError:(NSError *)error {
+    if (![keys count]) return;
+
+    NSArray *copied = keys.copy;
+    NSError *key = error ?: [NSError errorWithDomain:NSCocoaErrorDomain code:NSFileReadUnknownError userInfo:nil];
+    dispatch_async(_queue, ^{
+        NSMutableOrderedSet *failed = self.failedKeys[key];
+        if (!failed) {
+            failed = [NSMutableOrderedSet orderedSet];
+            self.failedKeys[key] = failed;
+        }
+        [self addKeys:copied toSet:failed];
+        [self didAddEvent];
+    });
+}
+
+- (void)addRetryObjects:(NSArray<id<ACCacheObject>> *)objects {
+    if (![objects count]) return;
+
+    NSArray *copied = objects.copy;
+    dispatch_async(_queue, ^{
+        NSMutableArray *keys = [NSMutableArray arrayWithCapacity:copied.count];
+        for (id <ACCacheObject> object in copied) {
+            NSString *key = object.objectID;
+            if (!key) continue;
+
+            [keys addObject:key];
+            if (self.retryObjects[key]) {
+                self.duplicateKeyCount++;
+            } else {
+                [self.retryKeys addObject:key];
+            }
+            self.retryObjects[key] = object;
+        }
+
+        // a retried key is no longer failed
+        [self cancelFailedKeys:keys];
+        [self didAddEvent];
+    });
+}
+
+/// Add keys to pending set and count duplicates, runs in queue
+- (void)addKeys:(NSArray <NSString *> *)keys toSet:(NSMutableOrderedSet <NSString *> *)set {
+    NSUInteger before = set.count;
+    [set addObjectsFromArray:keys];
+    self.duplicateKeyCount += keys.count - (set.count - before);
+}
+
+/// Drop pending keys superseded by a later success, runs in queue
+- (void)cancelKeys:(NSArray <NSString *> *)keys inSet:(NSMutableOrderedSet <NSString *> *)set {
+    if (!set.count) return;
+
+    NSUInteger before = set.count;
+    [set removeObjectsInArray:keys];
+    self.cancelledKeyCount += before - set.count;
+}
+
+/// Drop pending failures of keys, runs in queue
+- (void)cancelFailedKeys:(NSArray <NSString *> *)keys {
+    for (NSMutableOrderedSet *failed in self.failedKeys.allValues) {
+        [self cancelKeys:keys inSet:failed];
+    }
+}
+
+/// Count event and schedule delivery, runs in queue
+- (void)didAddEvent {
+    self.receivedEventCount++;
+    _pendingEventCount++;
+    if (_scheduled) return;
+
+    _scheduled = YES;
+    NSUInteger generation = _generation;
+    NSTimeInterval delay = MAX(0, _lastDelivery + self.interval - CACurrentMediaTime());
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(delay * NSEC_PER_SEC)), _queue, ^{
+        if (generation != self.generation) return;
+        [self deliver];
+    });
+}
+
+#pragma mark - Delivery
+- (void)flush {
+    dispatch_async(_queue, ^{
+        [self deliver];
+    });
+}
+
+/// Hand pending events to main queue as one batch, runs in queue
+- (void)deliver {
+    _scheduled = NO;
+    _generation++;
+    if (_pendingEventCount == 0) return;
+
+    ACCacheEventBatch *batch = [ACCacheEventBatch new];
+    batch.updatedKeys = _updatedKeys.array;
+    batch.trimmedKeys = _trimmedKeys.array;
+    NSMutableDictionary *failed = [NSMutableDictionary dictionaryWithCapacity:_failedKeys.count];
+    [_failedKeys enumerateKeysAndObjectsUsingBlock:^(NSError *error, NSMutableOrderedSet *keys, BOOL *stop) {
+        if (keys.count) failed[error] = keys.array.copy;
+    }];
+    batch.failedKeys = failed;
+    NSMutableArray *retried = [NSMutableArray arrayWithCapacity:_retryKeys.count];
+    for (NSString *key in _retryKeys) {
+        [retried addObject:_retryObjects[key]];
+    }
+    batch.retryObjects = retried;
+    batch.eventCount = _pendingEventCount;
+
+    self.deliveredBatchCount++;
+    self.foldedEventCount += _pendingEventCount - 1;
+    _pendingEventCount = 0;
+    _lastDelivery = CACurrentMediaTime();
+    [_updatedKeys removeAllObjects];
+    [_trimmedKeys removeAllObjects];
+    [_failedKeys removeAllObjects];
+    [_retryKeys removeAllObjects];
+    [_retryObjects removeAllObjects];
+
+    void (^handler)(ACCacheEventBatch *) = _handler;
+    dispatch_async(dispatch_get_main_queue(), ^{
+        handler(batch);
+    });
+}
+
+@end
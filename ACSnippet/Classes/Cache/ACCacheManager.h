@@ -10,6 +10,7 @@
 #import "ACCacheManagerDownloader.h"
 #import "ACCache.h"
 #import "ACCacheObject.h"
+#import "ACCacheEventCoalescer.h"
 
 
 @class ACCacheManager;
@@ -69,6 +70,10 @@
 /// Delegate object for ACCacheManager
 @property (nonatomic, weak) id <ACCacheManagerDelegate> delegate;
 
+/// Coalescer of update, trim, failure and retry delegate events, keys are deduplicated and delivered on main queue at most
+/// once per interval of coalescer, see its counters for folded events
+@property (nonatomic, strong, readonly) ACCacheEventCoalescer   *eventCoalescer;
+
 /// Designate initialzer for ACCacheManager with name, downloader and setting up cache object to disk or not
 /// @param name Name of ACCacheManager
 /// @param downloader Cache downloader
@@ -101,11 +106,23 @@
 /// @param keys Keys for object listing in downloader retry stack
 - (void)removeRetryObjectsForKeys:(NSArray <NSString *>*)keys;
 
-/// Store object and assign corresponed key for retrieving
+/// Store object and assign corresponed key for retrieving, priority is taken from objectPriority if object implements it,
+/// downloaded objects are stored the same way
 /// @param object Object to be stored
 /// @param key Key for object in storage
 - (void)setObject:(id <ACCacheObject>)object forKey:(NSString *)key;
 
+/// Store object with eviction priority class, see ACCache diskCountLimit and diskCostLimit
+/// @param object Object to be stored
+/// @param key Key for object in storage
+/// @param priority Priority class, e.g. tile zoom level or object type
+- (void)setObject:(id <ACCacheObject>)object forKey:(NSString *)key priority:(NSInteger)priority;
+
+/// Attach offline pack to storage and monitor its keys with pack versions, so version checkout only downloads changed objects.
+/// Pack keys are not monitored when avoidVersionCheckout is YES, as refresh would download all of them
+/// @param pack Offline pack, see ACCachePackWriter
+- (void)attachPack:(ACCachePack *)pack;
+
 /// Check if object with given key is exist in storage
 /// @param key Key for object in storage
 - (BOOL)containsObjectForKey:(NSString *)key;
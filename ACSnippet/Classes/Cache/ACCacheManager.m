@@ -45,12 +45,20 @@
         NSString *path = [self cacheToPathForName:name toDisk:disk];
         _storage = [[ACCache alloc] initWithName:name filePath:path];
         _storage.memoryCache.delegate = self;
+        // trims go through the event coalescer, which delivers on main queue by itself
+        _storage.memoryCache.notifiesTrimsOnTrimmingThread = YES;
         
         _refreshInterval = interval;
         _downloader = downloader;
         _monitoredKeysAndVersions = [YYThreadSafeDictionary new];
         _retryStack = [NSMutableSet set];
         
+        __weak typeof(self) _self = self;
+        _eventCoalescer = [[ACCacheEventCoalescer alloc] initWithInterval:1.0 / 60 deliveryHandler:^(ACCacheEventBatch *batch) {
+            __strong typeof(_self) self = _self;
+            [self deliverEventBatch:batch];
+        }];
+        
         [self registerReachibilityChanges];
     }
     
@@ -164,9 +172,7 @@
     [self.downloader downloadObjectsForKeys:keys completionHandler:^(NSError *error, NSArray<id<ACCacheObject>> *download) {
         __strong typeof(_self) self = _self;
         if (error) {
-            if (self.delegate && [self.delegate respondsToSelector:@selector(cacheManager:didFailToDownloadObjectsForKeys:withError:)]) {
-                [self.delegate cacheManager:self didFailToDownloadObjectsForKeys:keys withError:error];
-            }
+            [self.eventCoalescer addFailedKeys:keys withError:error];
             
             if (completion) {
                 completion(error);
@@ -187,22 +193,19 @@
             NSMutableArray *updated = @[].mutableCopy;
             for (id <ACCacheObject> obj in download) {
                 BOOL update = [self.storage containsObjectForKey:obj.objectID];
-                [self.storage setObject:obj forKey:obj.objectID];
+                [self setObject:obj forKey:obj.objectID];
                 [self.monitoredKeysAndVersions setObject:obj.objectVersion forKey:obj.objectID];
                 
                 if (!update) continue;
                 [updated addObject:obj.objectID];
             }
             
-            dispatch_async(dispatch_get_main_queue(), ^{
-                if (self.delegate && [self.delegate respondsToSelector:@selector(cacheManager:didUpdateObjectsForKeys:)]) {
-                    [self.delegate cacheManager:self didUpdateObjectsForKeys:updated.copy];
-                }
-                
-                if (completion) {
+            [self.eventCoalescer addUpdatedKeys:updated.copy];
+            if (completion) {
+                dispatch_async(dispatch_get_main_queue(), ^{
                     completion(nil);
-                }
-            });
+                });
+            }
         });
     }];
 }
@@ -232,7 +235,7 @@
             
             __strong typeof(_self) self = _self;
             for (id <ACCacheObject> object in download) {
-                [self.storage setObject:object forKey:object.objectID];
+                [self setObject:object forKey:object.objectID];
                 [self.monitoredKeysAndVersions setObject:object.objectVersion forKey:object.objectID];
             }
             
@@ -275,11 +278,7 @@
             [self.downloader downloadObjectsForKeys:filtered completionHandler:^(NSError *error, NSArray<id<ACCacheObject>> *download) {
                 __strong typeof(_self) self = _self;
                 if (error) {
-                    if (self.delegate && [self.delegate respondsToSelector:@selector(cacheManager:didFailToDownloadObjectsForKeys:withError:)]) {
-                        dispatch_async(dispatch_get_main_queue(), ^{
-                            [self.delegate cacheManager:self didFailToDownloadObjectsForKeys:filtered withError:error];
-                        });
-                    }
+                    [self.eventCoalescer addFailedKeys:filtered withError:error];
                        
                     if (!completion) {
                         [self retryDownloadObjectsForKeys:filtered];
@@ -294,7 +293,7 @@
                    
                 NSMutableArray *objects = @[].mutableCopy;
                 for (id <ACCacheObject> obj in download) {
-                    [self.storage setObject:obj forKey:obj.objectID];
+                    [self setObject:obj forKey:obj.objectID];
                     [self.monitoredKeysAndVersions setObject:obj.objectVersion forKey:obj.objectID];
                     [objects addObject:obj];
                 }
@@ -340,9 +339,7 @@
                         [self setObject:object forKey:object.objectID];
                     }
                     
-                    if (self.delegate && [self.delegate respondsToSelector:@selector(cacheManager:didDownloadRetryObjects:)]) {
-                        [self.delegate cacheManager:self didDownloadRetryObjects:download];
-                    }
+                    [self.eventCoalescer addRetryObjects:download];
                 }
                 
                 [self invalidateRetryTimer];
@@ -371,7 +368,30 @@
 }
 
 - (void)setObject:(id<ACCacheObject>)object forKey:(NSString *)key {
-    [_storage setObject:object forKey:key];
+    if ([object respondsToSelector:@selector(objectPriority)]) {
+        [_storage setObject:object forKey:key priority:[object objectPriority]];
+    } else {
+        [_storage setObject:object forKey:key];
+    }
+}
+
+- (void)setObject:(id<ACCacheObject>)object forKey:(NSString *)key priority:(NSInteger)priority {
+    [_storage setObject:object forKey:key priority:priority];
+}
+
+- (void)attachPack:(ACCachePack *)pack {
+    if (!pack) return;
+    
+    [_storage attachPack:pack];
+    // without version checkout every monitored key is downloaded on refresh, which would fetch the whole pack
+    if (_avoidVersionCheckout) return;
+    
+    [pack enumerateKeysAndVersionsUsingBlock:^(NSString *key, NSString *version, BOOL *stop) {
+        // objects already cached keep their own version, pack only fills in the rest
+        if (!self.monitoredKeysAndVersions[key]) {
+            [self.monitoredKeysAndVersions setObject:version forKey:key];
+        }
+    }];
 }
 
 - (BOOL)containsObjectForKey:(NSString *)key {
@@ -389,9 +409,32 @@
 #pragma mark - ACLRUCacheDelegate
 - (void)lruCache:(ACLRUCache *)cache didTrimObjectsForKeys:(NSArray<NSString *> *)keys {
     [self.monitoredKeysAndVersions removeObjectsForKeys:keys];
+    [self.eventCoalescer addTrimmedKeys:keys];
+}
+
+#pragma mark - Event Delivery
+/// Send coalesced events to delegate, runs on main queue
+/// @param batch Folded events
+- (void)deliverEventBatch:(ACCacheEventBatch *)batch {
+    id <ACCacheManagerDelegate> delegate = self.delegate;
+    if (!delegate) return;
+    
+    if ([batch.trimmedKeys count] && [delegate respondsToSelector:@selector(cacheManager:didTrimMemoryCachedObjectsForKeys:)]) {
+        [delegate cacheManager:self didTrimMemoryCachedObjectsForKeys:batch.trimmedKeys];
+    }
+    
+    if ([batch.failedKeys count] && [delegate respondsToSelector:@selector(cacheManager:didFailToDownloadObjectsForKeys:withError:)]) {
+        [batch.failedKeys enumerateKeysAndObjectsUsingBlock:^(NSError *error, NSArray<NSString *> *keys, BOOL *stop) {
+            [delegate cacheManager:self didFailToDownloadObjectsForKeys:keys withError:error];
+        }];
+    }
+    
+    if ([batch.updatedKeys count] && [delegate respondsToSelector:@selector(cacheManager:didUpdateObjectsForKeys:)]) {
+        [delegate cacheManager:self didUpdateObjectsForKeys:batch.updatedKeys];
+    }
     
-    if (self.delegate && [self.delegate respondsToSelector:@selector(cacheManager:didTrimMemoryCachedObjectsForKeys:)]) {
-        [self.delegate cacheManager:self didTrimMemoryCachedObjectsForKeys:keys];
+    if ([batch.retryObjects count] && [delegate respondsToSelector:@selector(cacheManager:didDownloadRetryObjects:)]) {
+        [delegate cacheManager:self didDownloadRetryObjects:batch.retryObjects];
     }
 }
 
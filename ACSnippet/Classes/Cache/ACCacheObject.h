@@ -17,5 +17,10 @@
 /// Object version for comparision
 - (NSString *)objectVersion;
 
+@optional
+
+/// Disk eviction priority class used when ACCacheManager stores the object, e.g. tile zoom level or object type, default is 0
+- (NSInteger)objectPriority;
+
 
 @end
@@ -0,0 +1,60 @@
+//
+//  ACCachePack.h
+//  ACSnippet
+//
+//  Created by Wenzhi WU on 19/10/2026.
+//  Copyright © 2026 Wenzhi WU. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+extern NSErrorDomain const ACCachePackErrorDomain;
+
+typedef NS_ENUM(NSInteger, ACCachePackError) {
+    ACCachePackErrorUnreadableFile = 1,
+    ACCachePackErrorInvalidFormat,
+    ACCachePackErrorUnwritableFile
+};
+
+/// Read-only offline pack of archived objects in one memory-mapped file, see ACCachePackWriter
+///
+/// Keys are resolved through a hashed index in O(1), entry data is returned without copying from the mapped file.
+/// Each entry carries the object version, so a pack can seed version checkout of ACCacheManager
+@interface ACCachePack : NSObject
+
+/// File path of pack
+@property (nonatomic, copy, readonly) NSString  *path;
+
+/// Number of entries
+@property (nonatomic, assign, readonly) NSUInteger  count;
+
+/// Map pack file, returns nil if file is missing or malformed
+/// @param path File path of pack
+/// @param error Set to ACCachePackErrorDomain error on failure
++ (nullable instancetype)packWithContentsOfFile:(NSString *)path error:(NSError **)error;
+
+/// Check if pack contains entry for key
+/// @param key Key for object
+- (BOOL)containsKey:(NSString *)key;
+
+/// Archived bytes of entry, the data refers to mapped file and keeps it mapped while alive
+/// @param key Key for object
+- (nullable NSData *)dataForKey:(NSString *)key;
+
+/// Unarchived object of entry
+/// @param key Key for object
+- (nullable id <NSCoding>)objectForKey:(NSString *)key;
+
+/// Version of entry
+/// @param key Key for object
+- (nullable NSString *)versionForKey:(NSString *)key;
+
+/// Enumerate keys and versions of all entries in file order
+/// @param block Enumeration block, set stop to YES to end enumeration
+- (void)enumerateKeysAndVersionsUsingBlock:(void (NS_NOESCAPE ^)(NSString *key, NSString *version, BOOL *stop))block;
+
+@end
+
+NS_ASSUME_NONNULL_END
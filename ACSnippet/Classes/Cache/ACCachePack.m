@@ -0,0 +1,201 @@
+//
+//  ACCachePack.m
+//  ACSnippet
+//
+//  Created by Wenzhi WU on 19/10/2026.
+//  Copyright © 2026 Wenzhi WU. All rights reserved.
+//
+
+#import "ACCachePack.h"
+#import "ACCachePackFormat.h"
+
+NSErrorDomain const ACCachePackErrorDomain = @"com.mrcrow.aicity.cache.pack";
+
+/// Keys up to this length are hashed from stack buffer
+#define ACCachePackKeyBufferSize 256
+
+/// Check byte range lies within blob region without overflow
+static inline BOOL ACCachePackRangeIsValid(uint64_t offset, uint64_t size, uint64_t start, uint64_t length) {
+    return offset >= start && size <= length && offset <= length - size;
+}
+
+@interface ACCachePack ()
+
+/// Mapped file content
+@property (nonatomic, strong) NSData *data;
+
+/// Header in mapped file
+@property (nonatomic, assign) const ACCachePackHeader *header;
+
+/// Buckets in mapped file
+@property (nonatomic, assign) const uint32_t *buckets;
+
+/// Entries in mapped file
+@property (nonatomic, assign) const ACCachePackEntry *entries;
+
+@end
+
+@implementation ACCachePack
+
++ (instancetype)packWithContentsOfFile:(NSString *)path error:(NSError **)error {
+    NSError *readError = nil;
+    NSData *data = [NSData dataWithContentsOfFile:path options:NSDataReadingMappedAlways error:&readError];
+    if (!data) {
+        if (error) {
+            *error = [NSError errorWithDomain:ACCachePackErrorDomain
+                                         code:ACCachePackErrorUnreadableFile
+                                     userInfo:readError ? @{NSLocalizedDescriptionKey: @"Pack file is not readable", NSUnderlyingErrorKey: readError} : @{NSLocalizedDescriptionKey: @"Pack file is not readable"}];
+        }
+        return nil;
+    }
+
+    if (![self validateData:data]) {
+        if (error) {
+            *error = [NSError errorWithDomain:ACCachePackErrorDomain
+                                         code:ACCachePackErrorInvalidFormat
+                                     userInfo:@{NSLocalizedDescriptionKey: [NSString stringWithFormat:@"%@ is not a valid pack", path.lastPathComponent]}];
+        }
+        return nil;
+    }
+
+    ACCachePack *pack = [self new];
+    pack->_path = path.copy;
+    pack->_data = data;
+    pack->_header = data.bytes;
+    pack->_buckets = (const uint32_t *)((const uint8_t *)data.bytes + sizeof(ACCachePackHeader));
+    pack->_entries = (const ACCachePackEntry *)((const uint8_t *)data.bytes + ACCachePackEntriesOffset(pack->_header->bucketCount));
+    pack->_count = pack->_header->entryCount;
+    return pack;
+}
+
+/// Check header, bucket table and entry ranges once so lookups need no bound checks
++ (BOOL)validateData:(NSData *)data {
+    uint64_t length = data.length;
+    if (length < sizeof(ACCachePackHeader)) return NO;
+
+    const ACCachePackHeader *header = data.bytes;
+    if (header->magic != ACCachePackMagic || header->formatVersion != ACCachePackFormatVersion) return NO;
+    if (header->bucketCount == 0 || (header->bucketCount & (header->bucketCount - 1)) || header->bucketCount <= header->entryCount) return NO;
+
+    uint64_t entriesOffset = ACCachePackEntriesOffset(header->bucketCount);
+    uint64_t blobOffset = entriesOffset + (uint64_t)header->entryCount * sizeof(ACCachePackEntry);
+    if (blobOffset > length) return NO;
+
+    // every entry sits in exactly one bucket, so an empty bucket remains and probing always ends
+    const uint32_t *buckets = (const uint32_t *)((const uint8_t *)data.bytes + sizeof(ACCachePackHeader));
+    uint8_t *seen = calloc(header->entryCount + 1, sizeof(uint8_t));
+    uint32_t occupied = 0;
+    BOOL valid = YES;
+    for (uint32_t i = 0; i < header->bucketCount; i++) {
+        uint32_t slot = buckets[i];
+        if (slot == 0) continue;
+
+        if (slot > header->entryCount || seen[slot]) {
+            valid = NO;
+            break;
+        }
+        seen[slot] = 1;
+        occupied++;
+    }
+    free(seen);
+    if (!valid || occupied != header->entryCount) return NO;
+
+    const ACCachePackEntry *entries = (const ACCachePackEntry *)((const uint8_t *)data.bytes + entriesOffset);
+    for (uint32_t i = 0; i < header->entryCount; i++) {
+        const ACCachePackEntry *entry = &entries[i];
+        if (!ACCachePackRangeIsValid(entry->keyOffset, entry->keyLength, blobOffset, length)) return NO;
+        if (!ACCachePackRangeIsValid(entry->versionOffset, entry->versionLength, blobOffset, length)) return NO;
+        if (!ACCachePackRangeIsValid(entry->dataOffset, entry->dataLength, blobOffset, length)) return NO;
+    }
+
+    return YES;
+}
+
+/// Entry for key, NULL if not found
+- (const ACCachePackEntry *)entryForKey:(NSString *)key {
+    if (!key || _count == 0) return NULL;
+
+    char buffer[ACCachePackKeyBufferSize];
+    NSUInteger length = 0;
+    NSRange remaining = NSMakeRange(0, 0);
+    const void *bytes = buffer;
+    NSData *encoded = nil;
+    BOOL fits = [key getBytes:buffer maxLength:sizeof(buffer) usedLength:&length encoding:NSUTF8StringEncoding options:0 range:NSMakeRange(0, key.length) remainingRange:&remaining];
+    if (!fits || remaining.length) {
+        encoded = [key dataUsingEncoding:NSUTF8StringEncoding];
+        bytes = encoded.bytes;
+        length = encoded.length;
+    }
+
+    const uint8_t *base = _data.bytes;
+    uint64_t hash = ACCachePackHash(bytes, length);
+    uint32_t mask = _header->bucketCount - 1;
+    for (uint32_t i = (uint32_t)hash & mask; ; i = (i + 1) & mask) {
+        uint32_t slot = _buckets[i];
+        if (slot == 0) return NULL;
+
+        const ACCachePackEntry *entry = &_entries[slot - 1];
+        if (entry->hash == hash && entry->keyLength == length && memcmp(base + entry->keyOffset, bytes, length) == 0) {
+            return entry;
+        }
+    }
+}
+
+- (BOOL)containsKey:(NSString *)key {
+    return [self entryForKey:key] != NULL;
+}
+
+- (NSData *)dataForKey:(NSString *)key {
+    const ACCachePackEntry *entry = [self entryForKey:key];
+    if (!entry) return nil;
+
+    // the deallocator holds mapped data, so the mapping outlives every entry handed out
+    NSData *mapped = _data;
+    return [[NSData alloc] initWithBytesNoCopy:(void *)((const uint8_t *)mapped.bytes + entry->dataOffset)
+                                        length:(NSUInteger)entry->dataLength
+                                   deallocator:^(void *bytes, NSUInteger length) {
+        (void)mapped;
+    }];
+}
+
+- (id<NSCoding>)objectForKey:(NSString *)key {
+    NSData *data = [self dataForKey:key];
+    if (!data) return nil;
+
+    id object = nil;
+    @try {
+        object = [NSKeyedUnarchiver unarchiveObjectWithData:data];
+    } @catch (NSException *exception) {
+        NSLog(@"ACCachePack: failed to unarchive object for key %@ (%@)", key, exception.reason);
+    }
+
+    return object;
+}
+
+- (NSString *)versionForKey:(NSString *)key {
+    const ACCachePackEntry *entry = [self entryForKey:key];
+    if (!entry) return nil;
+
+    return [[NSString alloc] initWithBytes:(const uint8_t *)_data.bytes + entry->versionOffset length:entry->versionLength encoding:NSUTF8StringEncoding];
+}
+
+- (void)enumerateKeysAndVersionsUsingBlock:(void (NS_NOESCAPE ^)(NSString *, NSString *, BOOL *))block {
+    if (!block) return;
+
+    const uint8_t *base = _data.bytes;
+    BOOL stop = NO;
+    for (NSUInteger i = 0; i < _count && !stop; i++) {
+        @autoreleasepool {
+            const ACCachePackEntry *entry = &_entries[i];
+            NSString *key = [[NSString alloc] initWithBytes:base + entry->keyOffset length:entry->keyLength encoding:NSUTF8StringEncoding];
+            NSString *version = [[NSString alloc] initWithBytes:base + entry->versionOffset length:entry->versionLength encoding:NSUTF8StringEncoding];
+            if (key && version) block(key, version, &stop);
+        }
+    }
+}
+
+- (NSString *)description {
+    return [NSString stringWithFormat:@"<%@: %p> (%@, %lu entries)", self.class, self, _path.lastPathComponent, (unsigned long)_count];
+}
+
+@end
@@ -0,0 +1,90 @@
+//
+//  ACCachePackFormat.h
+//  ACSnippet
+//
+//  Created by Wenzhi WU on 19/10/2026.
+//  Copyright © 2026 Wenzhi WU. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// File layout shared by ACCachePack and ACCachePackWriter, in native byte order:
+///
+///    header | buckets | padding to 8 bytes | entries | keys, versions and data
+///
+/// Buckets hold entry index plus one, 0 for empty, and are probed linearly from hash masked by bucket count.
+/// Offsets in entries are from start of file
+
+/// Magic number of pack file, "ACPK"
+#define ACCachePackMagic            0x4B504341
+/// Format version of pack file
+#define ACCachePackFormatVersion    1
+
+/// Header of pack file
+///
+/// Fields:
+///    magic:
+///        ACCachePackMagic
+///    formatVersion:
+///        ACCachePackFormatVersion
+///    entryCount:
+///        Number of entries
+///    bucketCount:
+///        Number of buckets, power of two and larger than entry count
+struct ACCachePackHeader {
+    uint32_t magic;
+    uint32_t formatVersion;
+    uint32_t entryCount;
+    uint32_t bucketCount;
+};
+typedef struct ACCachePackHeader ACCachePackHeader;
+
+/// Index entry of pack file
+///
+/// Fields:
+///    hash:
+///        ACCachePackHash of key
+///    keyOffset:
+///        Offset of UTF-8 key bytes
+///    versionOffset:
+///        Offset of UTF-8 version bytes
+///    dataOffset:
+///        Offset of archived object bytes
+///    dataLength:
+///        Length of archived object bytes
+///    keyLength:
+///        Length of key bytes
+///    versionLength:
+///        Length of version bytes
+struct ACCachePackEntry {
+    uint64_t hash;
+    uint64_t keyOffset;
+    uint64_t versionOffset;
+    uint64_t dataOffset;
+    uint64_t dataLength;
+    uint32_t keyLength;
+    uint32_t versionLength;
+};
+typedef struct ACCachePackEntry ACCachePackEntry;
+
+/// Offset of first entry for bucket count
+static inline uint64_t ACCachePackEntriesOffset(uint32_t bucketCount) {
+    uint64_t end = sizeof(ACCachePackHeader) + (uint64_t)bucketCount * sizeof(uint32_t);
+    return (end + 7) & ~(uint64_t)7;
+}
+
+/// FNV-1a hash of key bytes
+static inline uint64_t ACCachePackHash(const void *bytes, NSUInteger length) {
+    const uint8_t *p = bytes;
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (NSUInteger i = 0; i < length; i++) {
+        hash ^= p[i];
+        hash *= 0x100000001b3ULL;
+    }
+
+    return hash;
+}
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,51 @@
+//
+//  ACCachePackWriter.h
+//  ACSnippet
+//
+//  Created by Wenzhi WU on 19/10/2026.
+//  Copyright © 2026 Wenzhi WU. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import "ACCacheObject.h"
+#import "ACCache.h"
+#import "ACTileCollection.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// Builder of ACCachePack files, e.g. from objects of a campus prepared ahead of time or from an existing cache
+@interface ACCachePackWriter : NSObject
+
+/// Number of added entries
+@property (nonatomic, assign, readonly) NSUInteger  count;
+
+/// Add archived object bytes, a later entry with the same key replaces the earlier one
+/// @param data Archived bytes, as produced by NSKeyedArchiver
+/// @param key Key for object
+/// @param version Object version
+- (void)addData:(NSData *)data forKey:(NSString *)key version:(NSString *)version;
+
+/// Archive and add object with its object ID and version
+/// @param object Cache object
+- (void)addObject:(id <ACCacheObject>)object;
+
+/// Add objects stored in disk cache for keys, keys missing on disk, e.g. only served by an attached pack, are skipped
+/// @param keys Keys for objects
+/// @param cache Cache of ACCacheObject objects
+/// @return Number of added objects
+- (NSUInteger)addObjectsForKeys:(NSArray <NSString *>*)keys fromCache:(ACCache *)cache;
+
+/// Add objects stored in cache for tiles within collection, tile codes are used as keys
+/// @param collection Tile collection, e.g. from ACTileManager tileCollectionWithRange:
+/// @param cache Cache of ACCacheObject objects
+/// @return Number of added objects
+- (NSUInteger)addObjectsInTileCollection:(ACTileCollection *)collection fromCache:(ACCache *)cache;
+
+/// Write pack file atomically
+/// @param path File path of pack
+/// @param error Set to ACCachePackErrorDomain error on failure
+- (BOOL)writeToFile:(NSString *)path error:(NSError **)error;
+
+@end
+
+NS_ASSUME_NONNULL_END
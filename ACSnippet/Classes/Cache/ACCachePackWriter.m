@@ -0,0 +1,154 @@
+//
+//  ACCachePackWriter.m
+//  ACSnippet
+//
+//  Created by Wenzhi WU on 19/10/2026.
+//  Copyright © 2026 Wenzhi WU. All rights reserved.
+//
+
+#import "ACCachePackWriter.h"
+#import "ACCachePack.h"
+#import "ACCachePackFormat.h"
+
+@interface ACCachePackWriter ()
+
+/// Entry position for key
+@property (nonatomic, strong) NSMutableDictionary <NSString *, NSNumber *> *positions;
+
+/// UTF-8 keys in add order
+@property (nonatomic, strong) NSMutableArray <NSData *> *keys;
+
+/// UTF-8 versions in add order
+@property (nonatomic, strong) NSMutableArray <NSData *> *versions;
+
+/// Archived objects in add order
+@property (nonatomic, strong) NSMutableArray <NSData *> *objects;
+
+@end
+
+@implementation ACCachePackWriter
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _positions = @{}.mutableCopy;
+        _keys = @[].mutableCopy;
+        _versions = @[].mutableCopy;
+        _objects = @[].mutableCopy;
+    }
+
+    return self;
+}
+
+- (NSUInteger)count {
+    return _keys.count;
+}
+
+- (void)addData:(NSData *)data forKey:(NSString *)key version:(NSString *)version {
+    if (!data || !key) return;
+
+    NSData *versionBytes = [version ?: @"" dataUsingEncoding:NSUTF8StringEncoding];
+    NSNumber *position = _positions[key];
+    if (position) {
+        _versions[position.unsignedIntegerValue] = versionBytes;
+        _objects[position.unsignedIntegerValue] = data.copy;
+        return;
+    }
+
+    _positions[key] = @(_keys.count);
+    [_keys addObject:[key dataUsingEncoding:NSUTF8StringEncoding]];
+    [_versions addObject:versionBytes];
+    [_objects addObject:data.copy];
+}
+
+- (void)addObject:(id<ACCacheObject>)object {
+    NSData *data = [NSKeyedArchiver archivedDataWithRootObject:object];
+    [self addData:data forKey:object.objectID version:object.objectVersion];
+}
+
+- (NSUInteger)addObjectsForKeys:(NSArray<NSString *> *)keys fromCache:(ACCache *)cache {
+    NSUInteger added = 0;
+    for (NSString *key in keys) {
+        @autoreleasepool {
+            // disk cache only, so packing neither reads attached packs nor fills memory cache
+            id object = [cache.diskCache objectForKey:key];
+            if (![object conformsToProtocol:@protocol(ACCacheObject)]) continue;
+
+            NSData *data = [NSKeyedArchiver archivedDataWithRootObject:object];
+            [self addData:data forKey:key version:[(id <ACCacheObject>)object objectVersion]];
+            added++;
+        }
+    }
+
+    return added;
+}
+
+- (NSUInteger)addObjectsInTileCollection:(ACTileCollection *)collection fromCache:(ACCache *)cache {
+    return [self addObjectsForKeys:collection.tileCodes fromCache:cache];
+}
+
+- (BOOL)writeToFile:(NSString *)path error:(NSError **)error {
+    uint32_t entryCount = (uint32_t)_keys.count;
+    uint32_t bucketCount = 1;
+    // at most half full so probe sequences stay short
+    while (bucketCount < (uint64_t)entryCount * 2 || bucketCount <= entryCount) {
+        bucketCount <<= 1;
+    }
+
+    uint64_t entriesOffset = ACCachePackEntriesOffset(bucketCount);
+    uint64_t offset = entriesOffset + (uint64_t)entryCount * sizeof(ACCachePackEntry);
+    NSMutableData *file = [NSMutableData dataWithLength:(NSUInteger)offset];
+    ACCachePackHeader *header = file.mutableBytes;
+    header->magic = ACCachePackMagic;
+    header->formatVersion = ACCachePackFormatVersion;
+    header->entryCount = entryCount;
+    header->bucketCount = bucketCount;
+
+    ACCachePackEntry *entries = calloc(MAX(entryCount, 1), sizeof(ACCachePackEntry));
+    uint32_t *buckets = calloc(bucketCount, sizeof(uint32_t));
+    for (uint32_t i = 0; i < entryCount; i++) {
+        NSData *key = _keys[i], *version = _versions[i], *object = _objects[i];
+        ACCachePackEntry *entry = &entries[i];
+        entry->hash = ACCachePackHash(key.bytes, key.length);
+        entry->keyOffset = offset;
+        entry->keyLength = (uint32_t)key.length;
+        [file appendData:key];
+        offset += key.length;
+
+        entry->versionOffset = offset;
+        entry->versionLength = (uint32_t)version.length;
+        [file appendData:version];
+        offset += version.length;
+
+        entry->dataOffset = offset;
+        entry->dataLength = object.length;
+        [file appendData:object];
+        offset += object.length;
+
+        uint32_t mask = bucketCount - 1;
+        uint32_t slot = (uint32_t)entry->hash & mask;
+        while (buckets[slot]) {
+            slot = (slot + 1) & mask;
+        }
+        buckets[slot] = i + 1;
+    }
+
+    [file replaceBytesInRange:NSMakeRange(sizeof(ACCachePackHeader), bucketCount * sizeof(uint32_t)) withBytes:buckets];
+    [file replaceBytesInRange:NSMakeRange((NSUInteger)entriesOffset, entryCount * sizeof(ACCachePackEntry)) withBytes:entries];
+    free(buckets);
+    free(entries);
+
+    NSError *writeError = nil;
+    if (![file writeToFile:path options:NSDataWritingAtomic error:&writeError]) {
+        if (error) {
+            *error = [NSError errorWithDomain:ACCachePackErrorDomain
+                                         code:ACCachePackErrorUnwritableFile
+                                     userInfo:writeError ? @{NSLocalizedDescriptionKey: @"Pack file is not writable", NSUnderlyingErrorKey: writeError} : @{NSLocalizedDescriptionKey: @"Pack file is not writable"}];
+        }
+        return NO;
+    }
+
+    return YES;
+}
+
+@end
@@ -15,7 +15,7 @@ NS_ASSUME_NONNULL_BEGIN
 /// Delegate protocol of ACLRUCache object
 @protocol ACLRUCacheDelegate <NSObject>
 
-/// Invoked when object for keys were trimmed by limits
+/// Invoked on main thread when object for keys were trimmed by limits, once per trim
 /// @param cache ACLRUCache object
 /// @param keys Trimmed object keys
 - (void)lruCache:(ACLRUCache *)cache didTrimObjectsForKeys:(NSArray <NSString *>*)keys;
@@ -30,6 +30,10 @@ NS_ASSUME_NONNULL_BEGIN
 /// Delegate of ACLRUCache object
 @property (nonatomic, weak) id <ACLRUCacheDelegate> delegate;
 
+/// Notify delegate on the thread that trimmed, e.g. a background queue, instead of main thread, default NO.
+/// Only for a thread safe delegate that hands trims on by itself
+@property (atomic, assign) BOOL notifiesTrimsOnTrimmingThread;
+
 /// Number of cached objects
 @property (nonatomic, assign, readonly) NSUInteger totalCount;
 
@@ -399,9 +399,10 @@ static inline dispatch_queue_t ACLinkedMapGetReleaseQueue() {
         });
     }
     
+    NSString *trimmedKey = nil;
     if (_LRU.totalCount > _countLimit) {
         ACLinkedMapNode *node = [_LRU removeTailNode];
-        [self didTrimKeys:@[node.key]];
+        trimmedKey = node.key;
         if (_LRU.releaseAsynchronously) {
             dispatch_queue_t queue = _LRU.releaseOnMainThread ? dispatch_get_main_queue() : ACLinkedMapGetReleaseQueue();
             dispatch_async(queue, ^{
@@ -414,6 +415,9 @@ static inline dispatch_queue_t ACLinkedMapGetReleaseQueue() {
         }
     }
     pthread_mutex_unlock(&_lock);
+    
+    // reported outside the lock, delegate may read the cache
+    if (trimmedKey) [self didTrimKeys:@[trimmedKey]];
 }
 
 - (void)removeAllObjects {
@@ -426,17 +430,17 @@ static inline dispatch_queue_t ACLinkedMapGetReleaseQueue() {
     return [_LRU nodeKeys];
 }
 
-/// Notify delegate with trimmed keys
+/// Notify delegate with trimmed keys in one call, on main thread unless notifiesTrimsOnTrimmingThread
 /// @param keys Trimmed keys
 - (void)didTrimKeys:(NSArray <NSString *>*)keys {
-    if ([keys count] && self.delegate && [self.delegate respondsToSelector:@selector(lruCache:didTrimObjectsForKeys:)]) {
-        if (!pthread_main_np()) {
-            dispatch_async(dispatch_get_main_queue(), ^{
-                [self.delegate lruCache:self didTrimObjectsForKeys:keys];
-            });
-        } else {
+    if (![keys count] || ![self.delegate respondsToSelector:@selector(lruCache:didTrimObjectsForKeys:)]) return;
+    
+    if (self.notifiesTrimsOnTrimmingThread || pthread_main_np()) {
+        [self.delegate lruCache:self didTrimObjectsForKeys:keys];
+    } else {
+        dispatch_async(dispatch_get_main_queue(), ^{
             [self.delegate lruCache:self didTrimObjectsForKeys:keys];
-        }
+        });
     }
 }
 
@@ -459,7 +463,6 @@ static inline dispatch_queue_t ACLinkedMapGetReleaseQueue() {
         if (pthread_mutex_trylock(&_lock) == 0) {
             if (_LRU.totalCost > costLimit) {
                 ACLinkedMapNode *node = [_LRU removeTailNode];
-                [self didTrimKeys:@[node.key]];
                 if (node) [holder addObject:node];
             } else {
                 finish = YES;
@@ -471,6 +474,13 @@ static inline dispatch_queue_t ACLinkedMapGetReleaseQueue() {
     }
     
     if (holder.count) {
+        // one notification per trim instead of one per node
+        NSMutableArray *keys = [NSMutableArray arrayWithCapacity:holder.count];
+        for (ACLinkedMapNode *node in holder) {
+            [keys addObject:node.key];
+        }
+        [self didTrimKeys:keys];
+        
         dispatch_queue_t queue = _LRU.releaseOnMainThread ? dispatch_get_main_queue() : ACLinkedMapGetReleaseQueue();
         dispatch_async(queue, ^{
             [holder count];
@@ -497,7 +507,6 @@ static inline dispatch_queue_t ACLinkedMapGetReleaseQueue() {
         if (pthread_mutex_trylock(&_lock) == 0) {
             if (_LRU.totalCount > countLimit) {
                 ACLinkedMapNode *node = [_LRU removeTailNode];
-                [self didTrimKeys:@[node.key]];
                 if (node) [holder addObject:node];
             } else {
                 finish = YES;
@@ -509,6 +518,12 @@ static inline dispatch_queue_t ACLinkedMapGetReleaseQueue() {
     }
     
     if (holder.count) {
+        NSMutableArray *keys = [NSMutableArray arrayWithCapacity:holder.count];
+        for (ACLinkedMapNode *node in holder) {
+            [keys addObject:node.key];
+        }
+        [self didTrimKeys:keys];
+        
         dispatch_queue_t queue = _LRU.releaseOnMainThread ? dispatch_get_main_queue() : ACLinkedMapGetReleaseQueue();
         dispatch_async(queue, ^{
             [holder count];
@@ -536,7 +551,6 @@ static inline dispatch_queue_t ACLinkedMapGetReleaseQueue() {
         if (pthread_mutex_trylock(&_lock) == 0) {
             if (_LRU.tail && (now - _LRU.tail.time) > time) {
                 ACLinkedMapNode *node = [_LRU removeTailNode];
-                [self didTrimKeys:@[node.key]];
                 if (node) [holder addObject:node];
             } else {
                 finish = YES;
@@ -548,6 +562,12 @@ static inline dispatch_queue_t ACLinkedMapGetReleaseQueue() {
     }
     
     if (holder.count) {
+        NSMutableArray *keys = [NSMutableArray arrayWithCapacity:holder.count];
+        for (ACLinkedMapNode *node in holder) {
+            [keys addObject:node.key];
+        }
+        [self didTrimKeys:keys];
+        
         dispatch_queue_t queue = _LRU.releaseOnMainThread ? dispatch_get_main_queue() : ACLinkedMapGetReleaseQueue();
         dispatch_async(queue, ^{
             [holder count];
@@ -8,6 +8,7 @@
 
 #import <Foundation/Foundation.h>
 
+/// Linear helpers for pointer arrays, use ACWeakObjectSet for weak observer lists checked on hot paths
 @interface NSPointerArray (Helper)
 
 - (BOOL)containsObject:(id)object;
@@ -11,13 +11,23 @@
 @implementation NSPointerArray (Helper)
 
 - (BOOL)containsObject:(id)object {
-    NSArray *array = self.allObjects;
-    return [array containsObject:object];
+    if (!object) return NO;
+    
+    NSUInteger count = self.count;
+    for (NSUInteger i = 0; i < count; i++) {
+        // weak memory loads the pointer through the runtime, hold it strongly before messaging it
+        id candidate = (__bridge id)[self pointerAtIndex:i];
+        if (!candidate) continue;
+        if (candidate == object || [candidate isEqual:object]) return YES;
+    }
+    
+    return NO;
 }
 
 - (void)removeObject:(id)object {
     NSInteger index = -1;
-    for (int i = 0; i < self.count; i++) {
+    NSUInteger count = self.count;
+    for (NSUInteger i = 0; i < count; i++) {
         void *pointer = [self pointerAtIndex:i];
         if (pointer == (__bridge void*)object) {
             index = i;
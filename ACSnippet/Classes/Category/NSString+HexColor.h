@@ -11,10 +11,22 @@
 
 NS_ASSUME_NONNULL_BEGIN
 
+extern NSErrorDomain const ACHexColorErrorDomain;
+
+typedef NS_ENUM(NSInteger, ACHexColorError) {
+    ACHexColorErrorInvalidLength = 1,
+    ACHexColorErrorInvalidCharacter
+};
+
 @interface NSString (HexColor)
 
+/// Color of hex string in form of #RGB, #ARGB, #RRGGBB or #AARRGGBB, raises exception for invalid string
 - (UIColor *)hexColor;
 
+/// Color of hex string in form of #RGB, #ARGB, #RRGGBB or #AARRGGBB, repeated colors are served from a shared cache
+/// @param error Set to ACHexColorErrorDomain error for invalid string
+- (nullable UIColor *)hexColorWithError:(NSError **)error;
+
 @end
 
 NS_ASSUME_NONNULL_END
@@ -7,59 +7,130 @@
 //
 
 #import "NSString+HexColor.h"
+#import <pthread.h>
 
-@implementation NSString (HexColor)
+NSErrorDomain const ACHexColorErrorDomain = @"com.mrcrow.aicity.hexcolor";
 
-- (UIColor *)hexColor {
-    NSString *colorString = [[self stringByReplacingOccurrencesOfString:@"#" withString:@""] uppercaseString];
-    CGFloat alpha, red, blue, green;
-    switch ([colorString length]) {
-        case 3: {
-            // #RGB
-            alpha = 1.0f;
-            red   = [self colorComponentFrom:colorString start:0 length:1];
-            green = [self colorComponentFrom:colorString start:1 length:1];
-            blue  = [self colorComponentFrom:colorString start:2 length:1];
-        }
-            break;
+/// Number of cached colors, direct mapped by packed value
+#define HEX_COLOR_CACHE_SIZE 512
+
+static pthread_mutex_t ACHexColorCacheLock = PTHREAD_MUTEX_INITIALIZER;
+static uint32_t ACHexColorCacheKeys[HEX_COLOR_CACHE_SIZE];
+static CFTypeRef ACHexColorCacheColors[HEX_COLOR_CACHE_SIZE];
+
+static inline int ACHexDigitValue(UniChar character) {
+    if (character >= '0' && character <= '9') return character - '0';
+    if (character >= 'A' && character <= 'F') return character - 'A' + 10;
+    if (character >= 'a' && character <= 'f') return character - 'a' + 10;
+    return -1;
+}
+
+/// Parse hex string into packed ARGB value in one pass, '#' is skipped wherever it appears
+/// @param string Hex string
+/// @param argb Packed color value
+/// @return 0 on success, or ACHexColorError code
+static NSInteger ACHexColorParse(CFStringRef string, uint32_t *argb) {
+    CFIndex length = CFStringGetLength(string);
+    CFStringInlineBuffer buffer;
+    CFStringInitInlineBuffer(string, &buffer, CFRangeMake(0, length));
+    
+    uint32_t value = 0;
+    NSUInteger digits = 0;
+    for (CFIndex i = 0; i < length; i++) {
+        UniChar character = CFStringGetCharacterFromInlineBuffer(&buffer, i);
+        if (character == '#') continue;
+        
+        int digit = ACHexDigitValue(character);
+        if (digit < 0) return ACHexColorErrorInvalidCharacter;
+        if (++digits > 8) return ACHexColorErrorInvalidLength;
+        value = (value << 4) | (uint32_t)digit;
+    }
+    
+    switch (digits) {
+        case 3:
+            // #RGB, opaque alpha nibble is added and expanded with the #ARGB case
+            value |= 0xF000;
+            __attribute__((fallthrough));
         case 4: {
-            // #ARGB
-            alpha = [self colorComponentFrom:colorString start:0 length:1];
-            red   = [self colorComponentFrom:colorString start:1 length:1];
-            green = [self colorComponentFrom:colorString start:2 length:1];
-            blue  = [self colorComponentFrom:colorString start:3 length:1];
+            // #ARGB, each nibble is doubled
+            uint32_t expanded = 0;
+            for (int shift = 12; shift >= 0; shift -= 4) {
+                uint32_t nibble = (value >> shift) & 0xF;
+                expanded = (expanded << 8) | (nibble << 4) | nibble;
+            }
+            value = expanded;
         }
             break;
-        case 6: {
+        case 6:
             // #RRGGBB
-            alpha = 1.0f;
-            red   = [self colorComponentFrom:colorString start:0 length:2];
-            green = [self colorComponentFrom:colorString start:2 length:2];
-            blue  = [self colorComponentFrom:colorString start:4 length:2];
-        }
+            value |= 0xFF000000;
             break;
-        case 8: {
+        case 8:
             // #AARRGGBB
-            alpha = [self colorComponentFrom:colorString start:0 length:2];
-            red   = [self colorComponentFrom:colorString start:2 length:2];
-            green = [self colorComponentFrom:colorString start:4 length:2];
-            blue  = [self colorComponentFrom:colorString start:6 length:2];
-        }
             break;
         default:
-            [NSException raise:@"Invalid color value" format:@"Color value %@ is invalid.  It should be a hex value of the form #RBG, #ARGB, #RRGGBB, or #AARRGGBB", self];
-            break;
+            return ACHexColorErrorInvalidLength;
+    }
+    
+    *argb = value;
+    return 0;
+}
+
+/// Get shared color for packed value, colors are created once per cache slot
+/// @param argb Packed color value
+static UIColor *ACHexColorCachedColor(uint32_t argb) {
+    NSUInteger slot = (NSUInteger)((argb * 0x9E3779B1U) >> 23) % HEX_COLOR_CACHE_SIZE;
+    UIColor *color = nil;
+    pthread_mutex_lock(&ACHexColorCacheLock);
+    if (ACHexColorCacheColors[slot] && ACHexColorCacheKeys[slot] == argb) {
+        color = (__bridge UIColor *)ACHexColorCacheColors[slot];
     }
+    pthread_mutex_unlock(&ACHexColorCacheLock);
+    if (color) return color;
+    
+    color = [UIColor colorWithRed:((argb >> 16) & 0xFF) / 255.0
+                            green:((argb >> 8) & 0xFF) / 255.0
+                             blue:(argb & 0xFF) / 255.0
+                            alpha:(argb >> 24) / 255.0];
     
-    return [UIColor colorWithRed:red green:green blue:blue alpha:alpha];
+    CFTypeRef replaced = NULL;
+    pthread_mutex_lock(&ACHexColorCacheLock);
+    replaced = ACHexColorCacheColors[slot];
+    ACHexColorCacheColors[slot] = CFBridgingRetain(color);
+    ACHexColorCacheKeys[slot] = argb;
+    pthread_mutex_unlock(&ACHexColorCacheLock);
+    
+    // release replaced color out of lock
+    if (replaced) CFRelease(replaced);
+    return color;
 }
 
-- (CGFloat)colorComponentFrom:(NSString *)string start:(NSUInteger)start length:(NSUInteger)length {
-    NSString *substring = [string substringWithRange:NSMakeRange(start, length)];
-    NSString *fullHex = length == 2 ? substring :[NSString stringWithFormat:@"%@%@", substring, substring];
-    unsigned hexComponent;
-    [[NSScanner scannerWithString:fullHex] scanHexInt:&hexComponent];
-    return hexComponent / 255.0;
+@implementation NSString (HexColor)
+
+- (UIColor *)hexColor {
+    NSError *error = nil;
+    UIColor *color = [self hexColorWithError:&error];
+    if (!color) {
+        [NSException raise:@"Invalid color value" format:@"Color value %@ is invalid.  It should be a hex value of the form #RBG, #ARGB, #RRGGBB, or #AARRGGBB", self];
+    }
+    
+    return color;
+}
+
+- (UIColor *)hexColorWithError:(NSError **)error {
+    uint32_t argb = 0;
+    NSInteger code = ACHexColorParse((__bridge CFStringRef)self, &argb);
+    if (code != 0) {
+        if (error) {
+            NSString *reason = code == ACHexColorErrorInvalidLength ? @"unexpected number of hex digits" : @"non-hex character";
+            *error = [NSError errorWithDomain:ACHexColorErrorDomain
+                                         code:code
+                                     userInfo:@{NSLocalizedDescriptionKey: [NSString stringWithFormat:@"Color value %@ is invalid, %@. It should be a hex value of the form #RBG, #ARGB, #RRGGBB, or #AARRGGBB", self, reason]}];
+        }
+        return nil;
+    }
+    
+    return ACHexColorCachedColor(argb);
 }
 
 @end
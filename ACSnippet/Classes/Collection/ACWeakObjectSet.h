@@ -0,0 +1,48 @@
+//
+//  ACWeakObjectSet.h
+//  ACSnippet
+//
+//  Created by Wenzhi WU on 19/10/2026.
+//  Copyright © 2026 Wenzhi WU. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// Thread-safe set of weakly referenced objects compared by identity, for observer and delegate lists.
+/// Add, remove and contains are O(1) on average, slots of deallocated objects are skipped and compacted on growth
+@interface ACWeakObjectSet <ObjectType> : NSObject
+
+/// Number of live objects, counted by scanning slots
+@property (nonatomic, assign, readonly) NSUInteger count;
+
+/// Designate initializer for ACWeakObjectSet object
+/// @param capacity Expected number of objects
+- (instancetype)initWithCapacity:(NSUInteger)capacity;
+
+/// Add object, adding an object already in set has no effect
+/// @param object Object to reference weakly
+- (void)addObject:(ObjectType)object;
+
+/// Remove object
+/// @param object Object to remove
+- (void)removeObject:(ObjectType)object;
+
+/// Whether object is in set and alive
+/// @param object Object to check
+- (BOOL)containsObject:(ObjectType)object;
+
+/// Remove all objects
+- (void)removeAllObjects;
+
+/// Strong snapshot of live objects
+- (NSArray <ObjectType> *)allObjects;
+
+/// Enumerate snapshot of live objects, set may be mutated within block
+/// @param block Enumeration block, set stop to YES to end enumeration
+- (void)enumerateObjectsUsingBlock:(void (NS_NOESCAPE ^)(ObjectType object, BOOL *stop))block;
+
+@end
+
+NS_ASSUME_NONNULL_END
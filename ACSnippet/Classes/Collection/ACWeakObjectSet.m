@@ -0,0 +1,234 @@
+//
+//  ACWeakObjectSet.m
+//  ACSnippet
+//
+//  Created by Wenzhi WU on 19/10/2026.
+//  Copyright © 2026 Wenzhi WU. All rights reserved.
+//
+
+#import "ACWeakObjectSet.h"
+#import <pthread.h>
+
+/// Smallest slot table, must be power of two
+static const NSUInteger ACWeakObjectSetMinimumCapacity = 8;
+
+static inline NSUInteger ACWeakObjectHash(uintptr_t address) {
+    uint64_t hash = (uint64_t)(address >> 4) * 0x9E3779B97F4A7C15ULL;
+    return (NSUInteger)(hash ^ (hash >> 32));
+}
+
+@interface ACWeakObjectSet () {
+    __weak id   *_objects;
+    uintptr_t   *_addresses;
+    NSUInteger  _capacity;
+    NSUInteger  _used;
+}
+
+/// Lock for thread safe, readers share it
+@property (nonatomic, assign) pthread_rwlock_t lock;
+
+@end
+
+@implementation ACWeakObjectSet
+
+- (instancetype)init {
+    return [self initWithCapacity:0];
+}
+
+- (instancetype)initWithCapacity:(NSUInteger)capacity {
+    self = [super init];
+    if (self) {
+        pthread_rwlock_init(&_lock, NULL);
+        NSUInteger slots = ACWeakObjectSetMinimumCapacity;
+        while (slots < capacity * 2) slots <<= 1;
+        [self allocateSlots:slots];
+    }
+    
+    return self;
+}
+
+- (void)dealloc {
+    [self releaseSlots:_objects addresses:_addresses capacity:_capacity];
+    pthread_rwlock_destroy(&_lock);
+}
+
+- (NSUInteger)count {
+    // live objects are held by the snapshot until the lock is released
+    return [[self allObjects] count];
+}
+
+- (void)addObject:(id)object {
+    if (!object) return;
+    
+    uintptr_t address = (uintptr_t)(__bridge void *)object;
+    pthread_rwlock_wrlock(&_lock);
+    NSUInteger slot = [self slotForAddress:address];
+    if (slot != NSNotFound) {
+        // a deallocated object may have left its address behind
+        if (_objects[slot] != object) _objects[slot] = object;
+    } else {
+        if ((_used + 1) * 4 > _capacity * 3) {
+            [self rehashForAdditionalCount:1];
+        }
+        [self insertObject:object address:address];
+    }
+    pthread_rwlock_unlock(&_lock);
+}
+
+- (void)removeObject:(id)object {
+    if (!object) return;
+    
+    pthread_rwlock_wrlock(&_lock);
+    NSUInteger slot = [self slotForAddress:(uintptr_t)(__bridge void *)object];
+    if (slot != NSNotFound) {
+        [self removeSlot:slot];
+    }
+    pthread_rwlock_unlock(&_lock);
+}
+
+- (BOOL)containsObject:(id)object {
+    if (!object) return NO;
+    
+    // strong load is released after unlock, a last release would run dealloc and its removeObject: inside the lock
+    id stored = nil;
+    pthread_rwlock_rdlock(&_lock);
+    NSUInteger slot = [self slotForAddress:(uintptr_t)(__bridge void *)object];
+    if (slot != NSNotFound) stored = _objects[slot];
+    pthread_rwlock_unlock(&_lock);
+    return stored == object;
+}
+
+- (void)removeAllObjects {
+    pthread_rwlock_wrlock(&_lock);
+    for (NSUInteger i = 0; i < _capacity; i++) {
+        _objects[i] = nil;
+        _addresses[i] = 0;
+    }
+    _used = 0;
+    pthread_rwlock_unlock(&_lock);
+}
+
+- (NSArray *)allObjects {
+    NSMutableArray *objects = @[].mutableCopy;
+    pthread_rwlock_rdlock(&_lock);
+    for (NSUInteger i = 0; i < _capacity; i++) {
+        if (!_addresses[i]) continue;
+        
+        // the array takes the reference, so no object can be deallocated while the lock is held
+        id object = _objects[i];
+        if (object) [objects addObject:object];
+    }
+    pthread_rwlock_unlock(&_lock);
+    return objects.copy;
+}
+
+- (void)enumerateObjectsUsingBlock:(void (NS_NOESCAPE ^)(id, BOOL *))block {
+    if (!block) return;
+    
+    // enumerate a snapshot outside the lock, block may add or remove objects, e.g. an observer removing itself
+    BOOL stop = NO;
+    for (id object in [self allObjects]) {
+        block(object, &stop);
+        if (stop) break;
+    }
+}
+
+#pragma mark - Slots
+/// Allocate empty slot table
+/// @param capacity Number of slots, power of two
+- (void)allocateSlots:(NSUInteger)capacity {
+    _objects = (__weak id *)calloc(capacity, sizeof(id));
+    _addresses = calloc(capacity, sizeof(uintptr_t));
+    _capacity = capacity;
+    _used = 0;
+}
+
+/// Clear weak references before memory is freed
+- (void)releaseSlots:(__weak id *)objects addresses:(uintptr_t *)addresses capacity:(NSUInteger)capacity {
+    for (NSUInteger i = 0; i < capacity; i++) {
+        objects[i] = nil;
+    }
+    free(objects);
+    free(addresses);
+}
+
+/// Find slot by linear probing, lock should be held
+/// @param address Object address
+- (NSUInteger)slotForAddress:(uintptr_t)address {
+    NSUInteger mask = _capacity - 1;
+    NSUInteger index = ACWeakObjectHash(address) & mask;
+    while (_addresses[index]) {
+        if (_addresses[index] == address) return index;
+        index = (index + 1) & mask;
+    }
+    
+    return NSNotFound;
+}
+
+/// Insert object into first empty slot, write lock should be held
+- (void)insertObject:(id)object address:(uintptr_t)address {
+    NSUInteger mask = _capacity - 1;
+    NSUInteger index = ACWeakObjectHash(address) & mask;
+    while (_addresses[index]) {
+        index = (index + 1) & mask;
+    }
+    
+    _addresses[index] = address;
+    _objects[index] = object;
+    _used++;
+}
+
+/// Empty slot with backward shift so probing chains stay intact, write lock should be held
+/// @param slot Occupied slot
+- (void)removeSlot:(NSUInteger)slot {
+    NSUInteger mask = _capacity - 1;
+    NSUInteger hole = slot;
+    NSUInteger index = hole;
+    while (YES) {
+        index = (index + 1) & mask;
+        if (!_addresses[index]) break;
+        
+        // keep entry in place if its home slot lies cyclically within (hole, index]
+        NSUInteger home = ACWeakObjectHash(_addresses[index]) & mask;
+        BOOL inPlace = hole <= index ? (hole < home && home <= index) : (hole < home || home <= index);
+        if (inPlace) continue;
+        
+        // moving a weak slot loads it strongly, autorelease defers the release until the lock is gone
+        __autoreleasing id object = _objects[index];
+        _addresses[hole] = _addresses[index];
+        _objects[hole] = object;
+        hole = index;
+    }
+    
+    _addresses[hole] = 0;
+    _objects[hole] = nil;
+    _used--;
+}
+
+/// Rebuild table with live objects only, dead slots are dropped and table is sized for live objects,
+/// so the cost is amortized over the insertions that filled it, write lock should be held.
+/// Loaded objects are autoreleased so none of them can be deallocated under the lock
+/// @param count Number of objects about to be added
+- (void)rehashForAdditionalCount:(NSUInteger)count {
+    NSUInteger live = 0;
+    for (NSUInteger i = 0; i < _capacity; i++) {
+        if (_addresses[i] && _objects[i]) live++;
+    }
+    
+    NSUInteger capacity = ACWeakObjectSetMinimumCapacity;
+    while (capacity < (live + count) * 2) capacity <<= 1;
+    
+    __weak id *objects = _objects;
+    uintptr_t *addresses = _addresses;
+    NSUInteger previous = _capacity;
+    [self allocateSlots:capacity];
+    for (NSUInteger i = 0; i < previous; i++) {
+        if (!addresses[i]) continue;
+        
+        __autoreleasing id object = objects[i];
+        if (object) [self insertObject:object address:addresses[i]];
+    }
+    [self releaseSlots:objects addresses:addresses capacity:previous];
+}
+
+@end
@@ -0,0 +1,49 @@
+//
+//  ACCounterItemIndex.h
+//  ACSnippet
+//
+//  Created by Wenzhi WU on 19/10/2026.
+//  Copyright © 2026 Wenzhi WU. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import "ACCounterItem.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// Ordered index of counter items with O(1) lookup, removal, positioned insertion and access to last item
+@interface ACCounterItemIndex : NSObject
+
+/// Number of indexed items
+@property (nonatomic, assign, readonly) NSUInteger count;
+
+/// Most recently added item
+@property (nonatomic, strong, readonly, nullable) ACCounterItem *lastItem;
+
+/// Append item at the end, an existing item with same key is replaced
+/// @param item Counter item, nil key is allowed
+- (void)addItem:(ACCounterItem *)item;
+
+/// Insert item right after item of another key, an existing item with same key is replaced
+/// @param item Counter item, nil key is allowed
+/// @param key Key of preceding item, nil inserts at the head, item is appended when key is not indexed
+- (void)insertItem:(ACCounterItem *)item afterKey:(nullable NSString *)key;
+
+/// Get item for key
+/// @param key Reference key
+- (nullable ACCounterItem *)itemForKey:(nullable NSString *)key;
+
+/// Remove item for key
+/// @param key Reference key
+- (void)removeItemForKey:(nullable NSString *)key;
+
+/// Top layer identifier of item for key, walking down to the nearest item with layers
+/// @param key Reference key, the last item is used when key is not indexed
+- (nullable NSString *)lastLayerIdentifierAtOrBeforeKey:(nullable NSString *)key;
+
+/// All items in insertion order
+- (NSArray <ACCounterItem *>*)allItems;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,137 @@
+//
+//  ACCounterItemIndex.m
+//  ACSnippet
+//
+//  Created by Wenzhi WU on 19/10/2026.
+//  Copyright © 2026 Wenzhi WU. All rights reserved.
+//
+
+#import "ACCounterItemIndex.h"
+
+@interface ACCounterItemNode : NSObject
+
+/// Previous linked node
+@property (nonatomic, weak) ACCounterItemNode *previous;
+
+/// Next linked node
+@property (nonatomic, weak) ACCounterItemNode *next;
+
+/// Indexed item
+@property (nonatomic, strong) ACCounterItem *item;
+
+@end
+
+@implementation ACCounterItemNode
+@end
+
+
+@interface ACCounterItemIndex ()
+
+/// Key to node storage, nil key is stored as NSNull
+@property (nonatomic, strong) NSMutableDictionary <id, ACCounterItemNode *> *storage;
+
+/// Linked list head object
+@property (nonatomic, strong) ACCounterItemNode *head;
+
+/// Linked list tail object
+@property (nonatomic, strong) ACCounterItemNode *tail;
+
+@end
+
+@implementation ACCounterItemIndex
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _storage = @{}.mutableCopy;
+    }
+    
+    return self;
+}
+
+- (NSUInteger)count {
+    return [_storage count];
+}
+
+- (ACCounterItem *)lastItem {
+    return _tail.item;
+}
+
+/// Dictionary key for reference key
+/// @param key Reference key
+static inline id ACCounterItemIndexKey(NSString *key) {
+    return key ?: (id)[NSNull null];
+}
+
+- (void)addItem:(ACCounterItem *)item {
+    [self removeItemForKey:item.key];
+    
+    ACCounterItemNode *node = [ACCounterItemNode new];
+    node.item = item;
+    _storage[ACCounterItemIndexKey(item.key)] = node;
+    if (_tail) {
+        node.previous = _tail;
+        _tail.next = node;
+        _tail = node;
+    } else {
+        _head = _tail = node;
+    }
+}
+
+- (void)insertItem:(ACCounterItem *)item afterKey:(NSString *)key {
+    [self removeItemForKey:item.key];
+    
+    ACCounterItemNode *previous = key ? _storage[key] : nil;
+    if (key && !previous) {
+        [self addItem:item];
+        return;
+    }
+    
+    ACCounterItemNode *node = [ACCounterItemNode new];
+    node.item = item;
+    _storage[ACCounterItemIndexKey(item.key)] = node;
+    ACCounterItemNode *next = previous ? previous.next : _head;
+    node.previous = previous;
+    node.next = next;
+    if (previous) previous.next = node; else _head = node;
+    if (next) next.previous = node; else _tail = node;
+}
+
+- (ACCounterItem *)itemForKey:(NSString *)key {
+    return _storage[ACCounterItemIndexKey(key)].item;
+}
+
+- (void)removeItemForKey:(NSString *)key {
+    id storageKey = ACCounterItemIndexKey(key);
+    ACCounterItemNode *node = _storage[storageKey];
+    if (!node) return;
+    
+    if (node.next) node.next.previous = node.previous;
+    if (node.previous) node.previous.next = node.next;
+    if (_head == node) _head = node.next;
+    if (_tail == node) _tail = node.previous;
+    [_storage removeObjectForKey:storageKey];
+}
+
+- (NSString *)lastLayerIdentifierAtOrBeforeKey:(NSString *)key {
+    ACCounterItemNode *node = _storage[ACCounterItemIndexKey(key)];
+    if (!node) return _tail.item.layerIdentifiers.lastObject;
+    
+    for (; node; node = node.previous) {
+        NSString *identifier = node.item.layerIdentifiers.lastObject;
+        if (identifier) return identifier;
+    }
+    
+    return nil;
+}
+
+- (NSArray <ACCounterItem *>*)allItems {
+    NSMutableArray *mutable = [NSMutableArray arrayWithCapacity:[_storage count]];
+    for (ACCounterItemNode *node = _head; node; node = node.next) {
+        [mutable addObject:node.item];
+    }
+    
+    return mutable.copy;
+}
+
+@end
@@ -9,6 +9,7 @@
 #import <Foundation/Foundation.h>
 #import <Mapbox/Mapbox.h>
 #import "ACStyleLayerCounter.h"
+#import "ACCounterItem.h"
 
 NS_ASSUME_NONNULL_BEGIN
 
@@ -23,6 +24,12 @@ NS_ASSUME_NONNULL_BEGIN
 /// @param layers Style layers
 - (void)addKey:(NSString *)key withStyleLayers:(NSArray <MGLStyleLayer *> *)layers;
 
+/// Insert style layers with key right above layers of another key
+/// @param key Reference key
+/// @param layers Style layers
+/// @param aboveKey Key whose layers are right below, nil for bottom of counter
+- (void)insertKey:(NSString *)key withStyleLayers:(NSArray <MGLStyleLayer *> *)layers aboveKey:(nullable NSString *)aboveKey;
+
 /// Remove style layers with key from counter
 /// @param key Reference key
 - (void)removeKey:(NSString *)key;
@@ -31,6 +38,9 @@ NS_ASSUME_NONNULL_BEGIN
 /// @param key Reference key
 - (NSArray <NSString *> *)layerIdentifiersForKey:(NSString *)key;
 
+/// Counter items from bottom to top
+- (NSArray <ACCounterItem *> *)items;
+
 @end
 
 NS_ASSUME_NONNULL_END
@@ -8,10 +8,11 @@
 
 #import "ACKeyCounter.h"
 #import "ACCounterItem.h"
+#import "ACCounterItemIndex.h"
 
 @interface ACKeyCounter ()
 @property (nonatomic, copy) NSString    *type;
-@property (nonatomic, strong)   NSMutableArray <ACCounterItem *> *keyItems;
+@property (nonatomic, strong)   ACCounterItemIndex *keyItems;
 @end
 
 @implementation ACKeyCounter
@@ -20,48 +21,52 @@
     self = [super init];
     if (self) {
         _type = type;
-        _keyItems = @[].mutableCopy;
+        _keyItems = [ACCounterItemIndex new];
     }
     
     return self;
 }
 
 - (void)addKey:(NSString *)key withStyleLayers:(NSArray<MGLStyleLayer *> *)layers {
+    [_keyItems addItem:[self itemWithKey:key styleLayers:layers]];
+}
+
+- (void)insertKey:(NSString *)key withStyleLayers:(NSArray<MGLStyleLayer *> *)layers aboveKey:(NSString *)aboveKey {
+    [_keyItems insertItem:[self itemWithKey:key styleLayers:layers] afterKey:aboveKey];
+}
+
+- (ACCounterItem *)itemWithKey:(NSString *)key styleLayers:(NSArray<MGLStyleLayer *> *)layers {
     NSMutableArray *mutable = @[].mutableCopy;
     for (MGLStyleLayer *layer in layers) {
         [mutable addObject:layer.identifier];
     }
     
-    ACCounterItem *item = [[ACCounterItem alloc] initWithKey:key styleLayerIdentifiers:mutable.copy];
-    [_keyItems addObject:item];
+    return [[ACCounterItem alloc] initWithKey:key styleLayerIdentifiers:mutable.copy];
 }
 
 - (void)removeKey:(NSString *)key {
-    NSArray *result = [_keyItems filteredArrayUsingPredicate:[NSPredicate predicateWithFormat:@"key == %@", key]];
-    if (![result count]) return;
-    
-    ACCounterItem *item = result.firstObject;
-    [_keyItems removeObject:item];
+    [_keyItems removeItemForKey:key];
 }
 
 - (NSArray <NSString *> *)layerIdentifiersForKey:(NSString *)key {
-    NSArray <ACCounterItem *> *result = [_keyItems filteredArrayUsingPredicate:[NSPredicate predicateWithFormat:@"key == %@", key]];
-    if (![result count]) return nil;
-    
-    ACCounterItem *item = result.firstObject;
-    return item.layerIdentifiers;
+    return [_keyItems itemForKey:key].layerIdentifiers;
+}
+
+- (NSArray <ACCounterItem *> *)items {
+    return [_keyItems allItems];
 }
 
 #pragma mark - ACStyleLayerCounter
 - (BOOL)isEmpty {
-    return [_keyItems count] == 0;
+    return _keyItems.count == 0;
 }
 
 - (NSString *)lastLayerIdentifier {
-    if (![_keyItems count]) return nil;
-    
-    ACCounterItem *item = [_keyItems lastObject];
-    return item.layerIdentifiers.lastObject;
+    return _keyItems.lastItem.layerIdentifiers.lastObject;
+}
+
+- (NSString *)lastLayerIdentifierAtOrBelowKey:(NSString *)key {
+    return [_keyItems lastLayerIdentifierAtOrBeforeKey:key];
 }
 
 - (NSString *)counterType {
@@ -9,6 +9,7 @@
 #import <Foundation/Foundation.h>
 #import <Mapbox/Mapbox.h>
 #import "ACStyleLayerCounter.h"
+#import "ACCounterItem.h"
 
 NS_ASSUME_NONNULL_BEGIN
 
@@ -23,6 +24,12 @@ NS_ASSUME_NONNULL_BEGIN
 /// @param layers Style layers
 - (void)addSource:(nullable MGLSource *)source withStyleLayers:(NSArray <MGLStyleLayer *> *)layers;
 
+/// Insert source with related style layers right above layers of another source
+/// @param source MGLSource item
+/// @param layers Style layers
+/// @param identifier Identifier of source whose layers are right below, nil for bottom of counter
+- (void)insertSource:(nullable MGLSource *)source withStyleLayers:(NSArray <MGLStyleLayer *> *)layers aboveSourceIdentifier:(nullable NSString *)identifier;
+
 /// Remove source from counter
 /// @param source Source item
 - (void)removeSource:(MGLSource *)source;
@@ -31,6 +38,17 @@ NS_ASSUME_NONNULL_BEGIN
 /// @param source Target source 
 - (NSArray <NSString *> *)layerIdentifiersForSource:(MGLSource *)source;
 
+/// Remove source with identifier from counter
+/// @param identifier Source identifier
+- (void)removeSourceWithIdentifier:(nullable NSString *)identifier;
+
+/// Get style layer identifiers for source identifier
+/// @param identifier Source identifier
+- (NSArray <NSString *> *)layerIdentifiersForSourceIdentifier:(nullable NSString *)identifier;
+
+/// Counter items from bottom to top, item key is source identifier
+- (NSArray <ACCounterItem *> *)items;
+
 
 @end
 
@@ -8,10 +8,11 @@
 
 #import "ACSourceCounter.h"
 #import "ACCounterItem.h"
+#import "ACCounterItemIndex.h"
 
 @interface ACSourceCounter ()
 @property (nonatomic, copy) NSString    *type;
-@property (nonatomic, strong)   NSMutableArray <ACCounterItem *> *sourceItems;
+@property (nonatomic, strong)   ACCounterItemIndex *sourceItems;
 @end
 
 @implementation ACSourceCounter
@@ -20,7 +21,7 @@
     self = [super init];
     if (self) {
         _type = type;
-        _sourceItems = @[].mutableCopy;
+        _sourceItems = [ACCounterItemIndex new];
     }
     
     return self;
@@ -33,41 +34,53 @@
 }
 
 - (void)addSource:(MGLSource *)source withStyleLayers:(nonnull NSArray<MGLStyleLayer *> *)layers {
+    [_sourceItems addItem:[self itemWithSource:source styleLayers:layers]];
+}
+
+- (void)insertSource:(MGLSource *)source withStyleLayers:(NSArray<MGLStyleLayer *> *)layers aboveSourceIdentifier:(NSString *)identifier {
+    [_sourceItems insertItem:[self itemWithSource:source styleLayers:layers] afterKey:identifier];
+}
+
+- (ACCounterItem *)itemWithSource:(MGLSource *)source styleLayers:(NSArray<MGLStyleLayer *> *)layers {
     NSMutableArray *mutable = @[].mutableCopy;
     for (MGLStyleLayer *layer in layers) {
         [mutable addObject:layer.identifier];
     }
     
-    ACCounterItem *item = [[ACCounterItem alloc] initWithKey:source.identifier styleLayerIdentifiers:mutable.copy];
-    [_sourceItems addObject:item];
+    return [[ACCounterItem alloc] initWithKey:source.identifier styleLayerIdentifiers:mutable.copy];
 }
 
 - (void)removeSource:(MGLSource *)source {
-    NSArray *result = [_sourceItems filteredArrayUsingPredicate:[NSPredicate predicateWithFormat:@"key == %@", source.identifier]];
-    if (![result count]) return;
-    
-    ACCounterItem *item = result.firstObject;
-    [_sourceItems removeObject:item];
+    [self removeSourceWithIdentifier:source.identifier];
 }
 
 - (NSArray <NSString *> *)layerIdentifiersForSource:(MGLSource *)source {
-    NSArray <ACCounterItem *> *result = [_sourceItems filteredArrayUsingPredicate:[NSPredicate predicateWithFormat:@"key == %@", source.identifier]];
-    if (![result count]) return nil;
-    
-    ACCounterItem *item = result.firstObject;
-    return item.layerIdentifiers;
+    return [self layerIdentifiersForSourceIdentifier:source.identifier];
+}
+
+- (void)removeSourceWithIdentifier:(NSString *)identifier {
+    [_sourceItems removeItemForKey:identifier];
+}
+
+- (NSArray <NSString *> *)layerIdentifiersForSourceIdentifier:(NSString *)identifier {
+    return [_sourceItems itemForKey:identifier].layerIdentifiers;
+}
+
+- (NSArray <ACCounterItem *> *)items {
+    return [_sourceItems allItems];
 }
 
 #pragma mark - ACStyleLayerCounter
 - (BOOL)isEmpty {
-    return [_sourceItems count] == 0;
+    return _sourceItems.count == 0;
 }
 
 - (NSString *)lastLayerIdentifier {
-    if (![_sourceItems count]) return nil;
-    
-    ACCounterItem *item = [_sourceItems lastObject];
-    return item.layerIdentifiers.lastObject;
+    return _sourceItems.lastItem.layerIdentifiers.lastObject;
+}
+
+- (NSString *)lastLayerIdentifierAtOrBelowKey:(NSString *)key {
+    return [_sourceItems lastLayerIdentifierAtOrBeforeKey:key];
 }
 
 - (NSString *)counterType {
@@ -16,6 +16,10 @@ NS_ASSUME_NONNULL_BEGIN
 - (NSString *)counterType;
 - (NSString *)lastLayerIdentifier;
 
+/// Top layer identifier of key or nearest lower key with layers, last layer identifier when key is not counted
+/// @param key Reference key
+- (nullable NSString *)lastLayerIdentifierAtOrBelowKey:(nullable NSString *)key;
+
 @end
 
 NS_ASSUME_NONNULL_END
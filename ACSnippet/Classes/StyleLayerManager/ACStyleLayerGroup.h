@@ -0,0 +1,46 @@
+//
+//  ACStyleLayerGroup.h
+//  ACSnippet
+//
+//  Created by Wenzhi WU on 19/10/2026.
+//  Copyright © 2026 Wenzhi WU. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import <Mapbox/Mapbox.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// Desired style layers of one key or source within a layer type, used to reconcile ACStyleLayerManager
+@interface ACStyleLayerGroup : NSObject
+
+/// Layer type
+@property (nonatomic, copy, readonly) NSString  *type;
+
+/// Reference key, source identifier for source group
+@property (nonatomic, copy, readonly, nullable) NSString    *key;
+
+/// Source of style layers, nil for key group
+@property (nonatomic, strong, readonly, nullable) MGLSource *source;
+
+/// Style layers from bottom to top
+@property (nonatomic, copy, readonly) NSArray <MGLStyleLayer *> *layers;
+
+/// Identifiers of style layers
+@property (nonatomic, copy, readonly) NSArray <NSString *> *layerIdentifiers;
+
+/// Create group managed by key
+/// @param type Layer type
+/// @param key Reference key
+/// @param layers Style layers
++ (instancetype)groupWithType:(NSString *)type key:(NSString *)key layers:(NSArray <MGLStyleLayer *> *)layers;
+
+/// Create group managed by source, the source is added and removed with its layers
+/// @param type Layer type
+/// @param source Source of style layers
+/// @param layers Style layers
++ (instancetype)groupWithType:(NSString *)type source:(MGLSource *)source layers:(NSArray <MGLStyleLayer *> *)layers;
+
+@end
+
+NS_ASSUME_NONNULL_END
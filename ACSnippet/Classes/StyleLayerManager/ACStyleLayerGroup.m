@@ -0,0 +1,43 @@
+//
+//  ACStyleLayerGroup.m
+//  ACSnippet
+//
+//  Created by Wenzhi WU on 19/10/2026.
+//  Copyright © 2026 Wenzhi WU. All rights reserved.
+//
+
+#import "ACStyleLayerGroup.h"
+
+@implementation ACStyleLayerGroup
+
+- (instancetype)initWithType:(NSString *)type key:(NSString *)key source:(MGLSource *)source layers:(NSArray<MGLStyleLayer *> *)layers {
+    self = [super init];
+    if (self) {
+        _type = type;
+        _key = key;
+        _source = source;
+        _layers = layers;
+        
+        NSMutableArray *mutable = [NSMutableArray arrayWithCapacity:[layers count]];
+        for (MGLStyleLayer *layer in layers) {
+            [mutable addObject:layer.identifier];
+        }
+        _layerIdentifiers = mutable.copy;
+    }
+    
+    return self;
+}
+
++ (instancetype)groupWithType:(NSString *)type key:(NSString *)key layers:(NSArray<MGLStyleLayer *> *)layers {
+    return [[ACStyleLayerGroup alloc] initWithType:type key:key source:nil layers:layers];
+}
+
++ (instancetype)groupWithType:(NSString *)type source:(MGLSource *)source layers:(NSArray<MGLStyleLayer *> *)layers {
+    return [[ACStyleLayerGroup alloc] initWithType:type key:source.identifier source:source layers:layers];
+}
+
+- (NSString *)description {
+    return [NSString stringWithFormat:@"Group: %@[%@]\nLayers: %@", _type, _key, [_layerIdentifiers componentsJoinedByString:@", "]];
+}
+
+@end
@@ -8,6 +8,7 @@
 
 #import <Foundation/Foundation.h>
 #import <Mapbox/Mapbox.h>
+#import "ACStyleLayerGroup.h"
 
 NS_ASSUME_NONNULL_BEGIN
 
@@ -27,12 +28,33 @@ extern NSString *const ACStyleLayerTypeNavigationWaypointsLayer;
 extern NSString *const ACStyleLayerTypeNavigationInstructionsLayer;
 extern NSString *const ACStyleLayerTypeOutdoorPOILayer;
 
+/// Style operations used by ACStyleLayerManager, allows a mock style to stand in for MGLStyle
+@protocol ACStyleLayerManagerStyle <NSObject>
+
+- (nullable MGLStyleLayer *)layerWithIdentifier:(NSString *)identifier;
+- (void)insertLayer:(MGLStyleLayer *)layer aboveLayer:(MGLStyleLayer *)sibling;
+- (void)removeLayer:(MGLStyleLayer *)layer;
+- (void)addSource:(MGLSource *)source;
+- (void)removeSource:(MGLSource *)source;
+- (nullable MGLSource *)sourceWithIdentifier:(NSString *)identifier;
+
+@end
+
+@interface MGLStyle (ACStyleLayerManager) <ACStyleLayerManagerStyle>
+@end
+
 @interface ACStyleLayerManager : NSObject
 
 @property (nonatomic, assign, readonly) BOOL    readyForLayerManagement;
 
 + (instancetype)sharedManager;
 - (void)addToMapView:(MGLMapView *)mapView withBaseLayer:(MGLStyleLayer *)styleLayer;
+
+/// Manage layers of style directly, the style is not retained
+/// @param style Target style
+/// @param styleLayer Base layer, the lowest anchor of all managed layers
+- (void)addToStyle:(id <ACStyleLayerManagerStyle>)style withBaseLayer:(MGLStyleLayer *)styleLayer;
+
 - (void)registerLayerType:(NSString *)type aboveLayerType:(NSString *)above;
 - (void)registerLayerType:(NSString *)type belowLayerType:(NSString *)below;
 - (void)addSource:(MGLSource *)source withStyleLayers:(NSArray <MGLStyleLayer *> *)layers ofType:(NSString *)type;
@@ -40,6 +62,20 @@ extern NSString *const ACStyleLayerTypeOutdoorPOILayer;
 - (void)removeSource:(MGLSource *)source ofType:(NSString *)type;
 - (void)removeKey:(NSString *)key ofType:(NSString *)type;
 
+/// Queue following add and remove calls until the matching commitUpdates, transactions can be nested
+- (void)beginUpdates;
+
+/// Apply queued changes in one pass, a remove cancels pending add of the same key or source,
+/// removals go first, then additions are inserted type by type with one anchor lookup per run of stacked layers
+- (void)commitUpdates;
+
+/// Bring managed layers to the desired state with minimal changes, the longest run of unchanged groups kept in
+/// the same relative order stays in place, other groups are removed or inserted right above their desired
+/// predecessor, types without groups are emptied.
+/// Map view base layer is not touched
+/// @param groups All desired layer groups, groups of the same type are ordered from bottom to top
+- (void)reconcileWithLayerGroups:(NSArray <ACStyleLayerGroup *> *)groups;
+
 @end
 
 NS_ASSUME_NONNULL_END
@@ -9,6 +9,8 @@
 #import "ACStyleLayerManager.h"
 #import "ACSourceCounter.h"
 #import "ACKeyCounter.h"
+#import "ACCounterItem.h"
+#import "ACStyleLayerTypeOrder.h"
 
 NSString *const ACStyleLayerTypeMapViewBaseLayer = @"com.aicity.layer.map.base";
 NSString *const ACStyleLayerTypeBackgroundLayer = @"com.aicity.layer.background";
@@ -26,9 +28,71 @@ NSString *const ACStyleLayerTypeNavigationWaypointsLayer = @"com.aicity.layer.na
 NSString *const ACStyleLayerTypeNavigationInstructionsLayer = @"com.aicity.layer.navigation.instructions";
 NSString *const ACStyleLayerTypeOutdoorPOILayer = @"com.aicity.layer.outdoor.poi";
 
+@implementation MGLStyle (ACStyleLayerManager)
+@end
+
+/// Queued addition or removal of layers with key or source
+@interface ACStyleLayerUpdate : NSObject
+@property (nonatomic, copy) NSString    *type;
+@property (nonatomic, copy, nullable) NSString  *key;
+@property (nonatomic, strong, nullable) MGLSource   *source;
+@property (nonatomic, copy, nullable) NSArray <MGLStyleLayer *> *layers;
+@property (nonatomic, assign) BOOL  cancelled;
+@property (nonatomic, assign) BOOL  positioned;
+@property (nonatomic, copy, nullable) NSString  *aboveKey;
+
+- (instancetype)initWithType:(NSString *)type key:(nullable NSString *)key source:(nullable MGLSource *)source layers:(nullable NSArray <MGLStyleLayer *> *)layers;
+
+/// Identity of type and key, nil key is allowed
+- (id)identity;
+
+/// Place layers right above layers of another key instead of on top of type
+/// @param key Key whose layers are right below, nil for bottom of type
+- (void)positionAboveKey:(nullable NSString *)key;
+
+/// Place layers back on top of type
+- (void)positionOnTop;
+
+@end
+
+@implementation ACStyleLayerUpdate
+
+- (instancetype)initWithType:(NSString *)type key:(NSString *)key source:(MGLSource *)source layers:(NSArray<MGLStyleLayer *> *)layers {
+    self = [super init];
+    if (self) {
+        _type = type;
+        _key = key;
+        _source = source;
+        _layers = layers;
+    }
+    
+    return self;
+}
+
+- (id)identity {
+    return @[_type, _key ?: [NSNull null]];
+}
+
+- (void)positionAboveKey:(NSString *)key {
+    _positioned = YES;
+    _aboveKey = key;
+}
+
+- (void)positionOnTop {
+    _positioned = NO;
+    _aboveKey = nil;
+}
+
+@end
+
 @interface ACStyleLayerManager ()
 @property (nonatomic, weak) MGLMapView  *mapView;
-@property (nonatomic, strong)   NSMutableArray  *styleTypes;
+@property (nonatomic, weak) id <ACStyleLayerManagerStyle>   style;
+@property (nonatomic, assign)   NSUInteger  updateDepth;
+@property (nonatomic, strong)   NSMutableArray <ACStyleLayerUpdate *> *pendingAdditions;
+@property (nonatomic, strong)   NSMutableDictionary <id, ACStyleLayerUpdate *> *pendingAdditionMap;
+@property (nonatomic, strong)   NSMutableDictionary <id, ACStyleLayerUpdate *> *pendingRemovals;
+@property (nonatomic, strong)   ACStyleLayerTypeOrder   *typeOrder;
 @property (nonatomic, strong)   NSMutableDictionary <NSString *, id <ACStyleLayerCounter>> *counterMap;
 @end
 
@@ -47,201 +111,412 @@ NSString *const ACStyleLayerTypeOutdoorPOILayer = @"com.aicity.layer.outdoor.poi
 - (instancetype)init {
     self = [super init];
     if (self) {
-        _styleTypes = @[ACStyleLayerTypeMapViewBaseLayer,
-                        ACStyleLayerTypeBackgroundLayer,
-                        ACStyleLayerTypeBuildingFloorPlanBaseLayer,
-                        ACStyleLayerTypeBuildingAbstractionRegionLayer,
-                        ACStyleLayerTypeBuildingAbstractionLabelLayer,
-                        ACStyleLayerTypeBuildingFloorPlanPatternLayer,
-                        ACStyleLayerTypeBuildingFloorPlanLineLayer,
-                        ACStyleLayerTypeNavigationRoadsLayer,
-                        ACStyleLayerTypeNavigationInstructionsLayer,
-                        ACStyleLayerTypeBuildingFloorPlanStructureLayer,
-                        ACStyleLayerTypeNavigationWaypointsLayer,
-                        ACStyleLayerTypeBuildingFloorPlanPointLayer,
-                        ACStyleLayerTypeBuildingFloorPlanPOILayer,
-                        ACStyleLayerTypeBuildingOutlineLayer,
-                        ACStyleLayerTypeOutdoorPOILayer].mutableCopy;
+        _typeOrder = [[ACStyleLayerTypeOrder alloc] initWithTypes:@[ACStyleLayerTypeMapViewBaseLayer,
+                                                                    ACStyleLayerTypeBackgroundLayer,
+                                                                    ACStyleLayerTypeBuildingFloorPlanBaseLayer,
+                                                                    ACStyleLayerTypeBuildingAbstractionRegionLayer,
+                                                                    ACStyleLayerTypeBuildingAbstractionLabelLayer,
+                                                                    ACStyleLayerTypeBuildingFloorPlanPatternLayer,
+                                                                    ACStyleLayerTypeBuildingFloorPlanLineLayer,
+                                                                    ACStyleLayerTypeNavigationRoadsLayer,
+                                                                    ACStyleLayerTypeNavigationInstructionsLayer,
+                                                                    ACStyleLayerTypeBuildingFloorPlanStructureLayer,
+                                                                    ACStyleLayerTypeNavigationWaypointsLayer,
+                                                                    ACStyleLayerTypeBuildingFloorPlanPointLayer,
+                                                                    ACStyleLayerTypeBuildingFloorPlanPOILayer,
+                                                                    ACStyleLayerTypeBuildingOutlineLayer,
+                                                                    ACStyleLayerTypeOutdoorPOILayer]];
         _counterMap = @{}.mutableCopy;
+        _pendingAdditions = @[].mutableCopy;
+        _pendingAdditionMap = @{}.mutableCopy;
+        _pendingRemovals = @{}.mutableCopy;
     }
     
     return self;
 }
 
 - (void)addToMapView:(MGLMapView *)mapView withBaseLayer:(nonnull MGLStyleLayer *)styleLayer {
-    if (_mapView) return;
+    if (_mapView || _style) return;
     
     _mapView = mapView;
+    [self addBaseLayer:styleLayer];
+}
+
+- (void)addToStyle:(id<ACStyleLayerManagerStyle>)style withBaseLayer:(MGLStyleLayer *)styleLayer {
+    if (_mapView || _style) return;
+    
+    _style = style;
+    [self addBaseLayer:styleLayer];
+}
+
+- (void)addBaseLayer:(MGLStyleLayer *)styleLayer {
     _readyForLayerManagement = YES;
     ACKeyCounter *counter = [[ACKeyCounter alloc] initWithType:ACStyleLayerTypeMapViewBaseLayer];
     [counter addKey:@"default" withStyleLayers:@[styleLayer]];
     [_counterMap setObject:counter forKey:ACStyleLayerTypeMapViewBaseLayer];
+    [_typeOrder setType:ACStyleLayerTypeMapViewBaseLayer nonEmpty:YES];
 }
 
 - (void)registerLayerType:(NSString *)type aboveLayerType:(NSString *)above {
-    if (![_styleTypes containsObject:above]) {
+    if (![_typeOrder containsType:above]) {
         NSLog(@"ACStyleLayerManager failed to add %@ above %@, %@ not exist", type, above, above);
         return;
     }
     
-    if ([_styleTypes containsObject:type]) {
+    if ([_typeOrder containsType:type]) {
         NSLog(@"ACStyleLayerManager failed to add %@ above %@, %@ already exists", type, above, type);
         return;
     }
     
-    NSInteger index = [_styleTypes indexOfObject:above];
-    if (index + 1 >= [_styleTypes count]) {
-        [_styleTypes addObject:type];
-    } else {
-        [_styleTypes insertObject:type atIndex:index + 1];
-    }
+    [_typeOrder addType:type aboveType:above];
+    [self updateOccupancyOfType:type];
 }
 
 - (void)registerLayerType:(NSString *)type belowLayerType:(NSString *)below {
-    if (![_styleTypes containsObject:below]) {
+    if (![_typeOrder containsType:below]) {
         NSLog(@"ACStyleLayerManager failed to add %@ below %@, %@ not exist", type, below, below);
         return;
     }
     
-    if ([_styleTypes containsObject:type]) {
+    if ([_typeOrder containsType:type]) {
         NSLog(@"ACStyleLayerManager failed to add %@ below %@, %@ already exists", type, below, type);
         return;
     }
     
-    NSInteger index = [_styleTypes indexOfObject:below];
-    [_styleTypes insertObject:type atIndex:index];
+    [_typeOrder addType:type belowType:below];
+    [self updateOccupancyOfType:type];
 }
 
 - (void)addSource:(MGLSource *)source withStyleLayers:(NSArray<MGLStyleLayer *> *)layers ofType:(NSString *)type {
-    ACSourceCounter *counter = _counterMap[type];
-    if (!counter) {
-        counter = [[ACSourceCounter alloc] initWithType:type];
-        [_counterMap setObject:counter forKey:type];
+    [self beginUpdates];
+    [self queueUpdate:[[ACStyleLayerUpdate alloc] initWithType:type key:source.identifier source:source layers:layers] removal:NO];
+    [self commitUpdates];
+}
+
+- (void)addKey:(NSString *)key withStyleLayers:(NSArray<MGLStyleLayer *> *)layers ofType:(NSString *)type {
+    [self beginUpdates];
+    [self queueUpdate:[[ACStyleLayerUpdate alloc] initWithType:type key:key source:nil layers:layers] removal:NO];
+    [self commitUpdates];
+}
+
+- (void)removeSource:(MGLSource *)source ofType:(NSString *)type {
+    if (!_counterMap[type] && ![self hasPendingAdditionOfType:type]) {
+        NSLog(@"ACStyleLayerManager counter not found for type: %@", type);
+        return;
     }
+    
+    [self beginUpdates];
+    [self queueUpdate:[[ACStyleLayerUpdate alloc] initWithType:type key:source.identifier source:source layers:nil] removal:YES];
+    [self commitUpdates];
+}
 
-    if (counter.lastLayerIdentifier) {
-        MGLStyleLayer *aboveLayer = [_mapView.style layerWithIdentifier:counter.lastLayerIdentifier];
-        [_mapView.style addSource:source];
+- (void)removeKey:(NSString *)key ofType:(NSString *)type {
+    if (!_counterMap[type] && ![self hasPendingAdditionOfType:type]) {
+        NSLog(@"ACStyleLayerManager counter not found for type: %@", type);
+        return;
+    }
+    
+    [self beginUpdates];
+    [self queueUpdate:[[ACStyleLayerUpdate alloc] initWithType:type key:key source:nil layers:nil] removal:YES];
+    [self commitUpdates];
+}
+
+#pragma mark - Reconcile
+- (void)reconcileWithLayerGroups:(NSArray<ACStyleLayerGroup *> *)groups {
+    NSMutableDictionary <NSString *, NSMutableArray <ACStyleLayerGroup *> *> *desired = @{}.mutableCopy;
+    for (ACStyleLayerGroup *group in groups) {
+        if ([group.type isEqualToString:ACStyleLayerTypeMapViewBaseLayer]) continue;
         
-        for (MGLStyleLayer *layer in layers) {
-            [_mapView.style insertLayer:layer aboveLayer:aboveLayer];
-            aboveLayer = layer;
+        NSMutableArray *typeGroups = desired[group.type];
+        if (!typeGroups) {
+            typeGroups = @[].mutableCopy;
+            [desired setObject:typeGroups forKey:group.type];
         }
+        [typeGroups addObject:group];
+    }
+    
+    [self beginUpdates];
+    for (NSString *type in _counterMap.allKeys) {
+        if ([type isEqualToString:ACStyleLayerTypeMapViewBaseLayer] || desired[type]) continue;
         
-        [counter addSource:source withStyleLayers:layers];
-    } else {
-        ACSourceCounter *target = [self lowerCounterForInsertingLayerType:type];
-        if (!target) {
-            NSLog(@"ACStyleLayerManager lack of first counter");
-        } else {
-            MGLStyleLayer *aboveLayer = [_mapView.style layerWithIdentifier:target.lastLayerIdentifier];
-            [_mapView.style addSource:source];
-            
-            for (MGLStyleLayer *layer in layers) {
-                [_mapView.style insertLayer:layer aboveLayer:aboveLayer];
-                aboveLayer = layer;
-            }
-            
-            [counter addSource:source withStyleLayers:layers];
+        for (ACCounterItem *item in [self itemsOfCounter:_counterMap[type]]) {
+            [self queueUpdate:[[ACStyleLayerUpdate alloc] initWithType:type key:item.key source:nil layers:nil] removal:YES];
         }
     }
+    
+    [desired enumerateKeysAndObjectsUsingBlock:^(NSString *type, NSMutableArray<ACStyleLayerGroup *> *typeGroups, BOOL *stop) {
+        [self reconcileType:type withLayerGroups:typeGroups];
+    }];
+    [self commitUpdates];
 }
 
-- (void)addKey:(NSString *)key withStyleLayers:(NSArray<MGLStyleLayer *> *)layers ofType:(NSString *)type {
-    ACKeyCounter *counter = _counterMap[type];
-    if (!counter) {
-        counter = [[ACKeyCounter alloc] initWithType:type];
-        [_counterMap setObject:counter forKey:type];
-    }
-
-    if (counter.lastLayerIdentifier) {
-        MGLStyleLayer *aboveLayer = [_mapView.style layerWithIdentifier:counter.lastLayerIdentifier];
+/// Keep the longest common subsequence of counter items and desired groups, items outside it are removed
+/// and each missing group is inserted right above its desired predecessor, so a change in the middle of
+/// a type only touches the changed groups
+/// @param type Layer type
+/// @param groups Desired groups of type from bottom to top
+- (void)reconcileType:(NSString *)type withLayerGroups:(NSArray <ACStyleLayerGroup *> *)groups {
+    NSArray <ACCounterItem *> *items = [self itemsOfCounter:_counterMap[type]];
+    NSMutableDictionary <id, NSNumber *> *positions = [NSMutableDictionary dictionaryWithCapacity:items.count];
+    [items enumerateObjectsUsingBlock:^(ACCounterItem *item, NSUInteger idx, BOOL *stop) {
+        positions[item.key ?: [NSNull null]] = @(idx);
+    }];
+    
+    // keys are unique within a counter, so the common subsequence is the longest increasing run
+    // of item positions matched by groups, found by patience sorting
+    NSUInteger count = groups.count;
+    NSUInteger *matched = malloc(MAX(count, 1) * sizeof(NSUInteger));
+    NSUInteger *parents = malloc(MAX(count, 1) * sizeof(NSUInteger));
+    NSUInteger *tails = malloc(MAX(count, 1) * sizeof(NSUInteger));
+    NSUInteger length = 0;
+    for (NSUInteger i = 0; i < count; i++) {
+        ACStyleLayerGroup *group = groups[i];
+        NSNumber *position = positions[group.key ?: [NSNull null]];
+        matched[i] = NSNotFound;
+        parents[i] = NSNotFound;
+        if (!position || ![items[position.unsignedIntegerValue].layerIdentifiers isEqualToArray:group.layerIdentifiers]) continue;
         
-        for (MGLStyleLayer *layer in layers) {
-            [_mapView.style insertLayer:layer aboveLayer:aboveLayer];
-            aboveLayer = layer;
+        matched[i] = position.unsignedIntegerValue;
+        NSUInteger low = 0, high = length;
+        while (low < high) {
+            NSUInteger mid = (low + high) / 2;
+            if (matched[tails[mid]] < matched[i]) low = mid + 1; else high = mid;
         }
+        if (low > 0) parents[i] = tails[low - 1];
+        tails[low] = i;
+        if (low == length) length++;
+    }
+    
+    NSMutableIndexSet *keptGroups = [NSMutableIndexSet indexSet];
+    NSMutableIndexSet *keptItems = [NSMutableIndexSet indexSet];
+    for (NSUInteger i = length ? tails[length - 1] : NSNotFound; i != NSNotFound; i = parents[i]) {
+        [keptGroups addIndex:i];
+        [keptItems addIndex:matched[i]];
+    }
+    free(matched);
+    free(parents);
+    free(tails);
+    
+    for (NSUInteger i = 0; i < items.count; i++) {
+        if ([keptItems containsIndex:i]) continue;
+        [self queueUpdate:[[ACStyleLayerUpdate alloc] initWithType:type key:items[i].key source:nil layers:nil] removal:YES];
+    }
+    
+    for (NSUInteger i = 0; i < count; i++) {
+        if ([keptGroups containsIndex:i]) continue;
         
-        [counter addKey:key withStyleLayers:layers];
-    } else {
-        id <ACStyleLayerCounter> target = [self lowerCounterForInsertingLayerType:type];
-        if (!target) {
-            NSLog(@"ACStyleLayerManager lack of first counter");
-        } else {
-            MGLStyleLayer *aboveLayer = [_mapView.style layerWithIdentifier:target.lastLayerIdentifier];
-            
-            for (MGLStyleLayer *layer in layers) {
-                [_mapView.style insertLayer:layer aboveLayer:aboveLayer];
-                aboveLayer = layer;
-            }
-            
-            [counter addKey:key withStyleLayers:layers];
-        }
+        ACStyleLayerGroup *group = groups[i];
+        ACStyleLayerUpdate *update = [[ACStyleLayerUpdate alloc] initWithType:type key:group.key source:group.source layers:group.layers];
+        [update positionAboveKey:i > 0 ? groups[i - 1].key : nil];
+        [self queueUpdate:update removal:NO];
     }
 }
 
-- (void)removeSource:(MGLSource *)source ofType:(NSString *)type {
-    ACSourceCounter *counter = _counterMap[type];
-    if (!counter) {
-        NSLog(@"ACStyleLayerManager counter not found for type: %@", type);
+- (NSArray <ACCounterItem *> *)itemsOfCounter:(id <ACStyleLayerCounter>)counter {
+    if ([counter isKindOfClass:[ACSourceCounter class]]) return [(ACSourceCounter *)counter items];
+    if ([counter isKindOfClass:[ACKeyCounter class]]) return [(ACKeyCounter *)counter items];
+    return nil;
+}
+
+#pragma mark - Transaction
+- (void)beginUpdates {
+    _updateDepth++;
+}
+
+- (void)commitUpdates {
+    if (_updateDepth == 0) {
+        NSLog(@"ACStyleLayerManager commitUpdates without beginUpdates");
         return;
     }
     
-    NSArray <NSString *> *layerIDs = [counter layerIdentifiersForSource:source];
-    if ([layerIDs count]) {
-        for (NSString *identifier in layerIDs) {
-            MGLStyleLayer *layer = [_mapView.style layerWithIdentifier:identifier];
-            if (layer) {
-                [_mapView.style removeLayer:layer];
-            }
-        }
-        
-        [_mapView.style removeSource:source];
+    if (--_updateDepth > 0) return;
+    
+    NSArray <ACStyleLayerUpdate *> *removals = _pendingRemovals.allValues;
+    NSArray <ACStyleLayerUpdate *> *additions = _pendingAdditions.copy;
+    [_pendingRemovals removeAllObjects];
+    [_pendingAdditions removeAllObjects];
+    [_pendingAdditionMap removeAllObjects];
+    
+    id <ACStyleLayerManagerStyle> style = [self currentStyle];
+    for (ACStyleLayerUpdate *update in removals) {
+        [self applyRemoval:update toStyle:style];
     }
     
-    [counter removeSource:source];
+    [self applyAdditions:additions toStyle:style];
 }
 
-- (void)removeKey:(NSString *)key ofType:(NSString *)type {
-    ACKeyCounter *counter = _counterMap[type];
-    if (!counter) {
-        NSLog(@"ACStyleLayerManager counter not found for type: %@", type);
-        return;
+/// Queue update, an addition also queues removal of current layers with the same key so they are replaced,
+/// and a removal drops pending addition with the same key
+/// @param update Queued update
+/// @param removal Whether update removes layers
+- (void)queueUpdate:(ACStyleLayerUpdate *)update removal:(BOOL)removal {
+    id identity = update.identity;
+    ACStyleLayerUpdate *pending = _pendingAdditionMap[identity];
+    if (pending) {
+        pending.cancelled = YES;
+        [_pendingAdditionMap removeObjectForKey:identity];
     }
     
-    NSArray <NSString *> *layerIDs = [counter layerIdentifiersForKey:key];
-    if ([layerIDs count]) {
-        for (NSString *identifier in layerIDs) {
-            MGLStyleLayer *layer = [_mapView.style layerWithIdentifier:identifier];
-            if (layer) {
-                [_mapView.style removeLayer:layer];
-            }
+    if (!_pendingRemovals[identity]) {
+        ACStyleLayerUpdate *removalUpdate = removal ? update : [[ACStyleLayerUpdate alloc] initWithType:update.type key:update.key source:update.source layers:nil];
+        [_pendingRemovals setObject:removalUpdate forKey:identity];
+    }
+    
+    if (!removal) {
+        [_pendingAdditions addObject:update];
+        [_pendingAdditionMap setObject:update forKey:identity];
+    }
+}
+
+- (BOOL)hasPendingAdditionOfType:(NSString *)type {
+    for (ACStyleLayerUpdate *update in _pendingAdditionMap.objectEnumerator) {
+        if ([update.type isEqualToString:type]) return YES;
+    }
+    
+    return NO;
+}
+
+- (void)applyRemoval:(ACStyleLayerUpdate *)update toStyle:(id <ACStyleLayerManagerStyle>)style {
+    id <ACStyleLayerCounter> counter = _counterMap[update.type];
+    if (!counter) return;
+    
+    BOOL bySource = [counter isKindOfClass:[ACSourceCounter class]];
+    NSArray <NSString *> *layerIDs = bySource ? [(ACSourceCounter *)counter layerIdentifiersForSourceIdentifier:update.key] : [(ACKeyCounter *)counter layerIdentifiersForKey:update.key];
+    if (![layerIDs count]) return;
+    
+    for (NSString *identifier in layerIDs) {
+        MGLStyleLayer *layer = [style layerWithIdentifier:identifier];
+        if (layer) {
+            [style removeLayer:layer];
         }
     }
     
-    [counter removeKey:key];
+    if (bySource) {
+        // source of update may be a new object never added to style, the added one is found by identifier
+        MGLSource *source = update.key ? [style sourceWithIdentifier:update.key] : nil;
+        if (source) {
+            [style removeSource:source];
+        }
+        [(ACSourceCounter *)counter removeSourceWithIdentifier:update.key];
+    } else {
+        [(ACKeyCounter *)counter removeKey:update.key];
+    }
+    [self updateOccupancyOfType:update.type];
 }
 
-- (id <ACStyleLayerCounter>)lowerCounterForInsertingLayerType:(NSString *)type {
-    id <ACStyleLayerCounter> result = nil;
-    NSInteger index = [_styleTypes indexOfObject:type];
-    if (index == NSNotFound) return nil;
-    if (index == 0) {
-        NSString *target = _styleTypes.firstObject;
-        id <ACStyleLayerCounter> counter = _counterMap[target];
-        return counter;
-    }
-    
-    for (int i = (int)index - 1; i >= 0; i--) {
-        NSString *target = _styleTypes[i];
-        id <ACStyleLayerCounter> counter = _counterMap[target];
-        if (counter && ![counter isEmpty]) {
-            result = counter;
-            break;
+- (void)applyAdditions:(NSArray <ACStyleLayerUpdate *> *)additions toStyle:(id <ACStyleLayerManagerStyle>)style {
+    NSMutableDictionary <NSString *, NSMutableArray <ACStyleLayerUpdate *> *> *groups = @{}.mutableCopy;
+    for (ACStyleLayerUpdate *update in additions) {
+        if (update.cancelled) continue;
+        
+        NSMutableArray *group = groups[update.type];
+        if (!group) {
+            group = @[].mutableCopy;
+            [groups setObject:group forKey:update.type];
         }
+        [group addObject:update];
     }
     
-    return result;
+    // lower types first, so an empty type above can anchor on layers added in the same pass
+    NSArray <NSString *> *types = [groups.allKeys sortedArrayUsingComparator:^NSComparisonResult(NSString *obj1, NSString *obj2) {
+        return [self.typeOrder compareType:obj1 toType:obj2];
+    }];
+    
+    for (NSString *type in types) {
+        NSArray <ACStyleLayerUpdate *> *group = groups[type];
+        BOOL bySource = group.firstObject.source != nil;
+        id <ACStyleLayerCounter> counter = _counterMap[type];
+        if (!counter) {
+            counter = bySource ? [[ACSourceCounter alloc] initWithType:type] : [[ACKeyCounter alloc] initWithType:type];
+            [_counterMap setObject:counter forKey:type];
+        }
+        
+        // a run of updates stacked on each other shares one anchor lookup
+        MGLStyleLayer *aboveLayer = nil;
+        ACStyleLayerUpdate *previous = nil;
+        for (ACStyleLayerUpdate *update in group) {
+            BOOL stacked = previous && (update.positioned ? [update.aboveKey isEqualToString:previous.key] : !previous.positioned);
+            if (!stacked || !aboveLayer) {
+                aboveLayer = [self anchorLayerForUpdate:update counter:counter style:style];
+            }
+            previous = update;
+            if (!aboveLayer) continue;
+            
+            if ([counter isKindOfClass:[ACSourceCounter class]]) {
+                if (update.source) {
+                    [style addSource:update.source];
+                }
+                if (update.positioned) {
+                    [(ACSourceCounter *)counter insertSource:update.source withStyleLayers:update.layers aboveSourceIdentifier:update.aboveKey];
+                } else {
+                    [(ACSourceCounter *)counter addSource:update.source withStyleLayers:update.layers];
+                }
+            } else {
+                if (update.positioned) {
+                    [(ACKeyCounter *)counter insertKey:update.key withStyleLayers:update.layers aboveKey:update.aboveKey];
+                } else {
+                    [(ACKeyCounter *)counter addKey:update.key withStyleLayers:update.layers];
+                }
+            }
+            
+            for (MGLStyleLayer *layer in update.layers) {
+                [style insertLayer:layer aboveLayer:aboveLayer];
+                aboveLayer = layer;
+            }
+        }
+        [self updateOccupancyOfType:type];
+    }
+}
+
+/// Layer right below where layers of update go, top of type for unpositioned update,
+/// otherwise top of the key it is placed above or of the nearest lower non-empty type.
+/// A positioned update whose anchor is missing from style is moved on top of type
+- (MGLStyleLayer *)anchorLayerForUpdate:(ACStyleLayerUpdate *)update counter:(id <ACStyleLayerCounter>)counter style:(id <ACStyleLayerManagerStyle>)style {
+    if (update.positioned) {
+        NSString *anchorID = [self positionedAnchorIdentifierForUpdate:update counter:counter];
+        MGLStyleLayer *layer = anchorID ? [style layerWithIdentifier:anchorID] : nil;
+        if (layer) return layer;
+        
+        // layers replaced by update are removed already, so it is added on top instead of dropped
+        NSLog(@"ACStyleLayerManager anchor layer %@ not found for key %@, adding on top of type: %@", anchorID, update.key, update.type);
+        [update positionOnTop];
+    }
+    
+    NSString *anchorID = counter.lastLayerIdentifier ?: [self lowerCounterForInsertingLayerType:update.type].lastLayerIdentifier;
+    if (!anchorID) {
+        NSLog(@"ACStyleLayerManager lack of first counter");
+        return nil;
+    }
+    
+    MGLStyleLayer *layer = [style layerWithIdentifier:anchorID];
+    if (!layer) {
+        NSLog(@"ACStyleLayerManager anchor layer %@ not found for type: %@", anchorID, update.type);
+    }
+    
+    return layer;
+}
+
+/// Top layer of the key a positioned update is placed above, or of the nearest lower non-empty type
+- (NSString *)positionedAnchorIdentifierForUpdate:(ACStyleLayerUpdate *)update counter:(id <ACStyleLayerCounter>)counter {
+    // a key without layers is skipped, and a missing one means the update is appended on top
+    NSString *anchorID = update.aboveKey ? [counter lastLayerIdentifierAtOrBelowKey:update.aboveKey] : nil;
+    return anchorID ?: [self lowerCounterForInsertingLayerType:update.type].lastLayerIdentifier;
+}
+
+- (id <ACStyleLayerManagerStyle>)currentStyle {
+    return _style ?: _mapView.style;
+}
+
+- (id <ACStyleLayerCounter>)lowerCounterForInsertingLayerType:(NSString *)type {
+    NSString *target = [_typeOrder nearestNonEmptyTypeBelowType:type];
+    return target ? _counterMap[target] : nil;
+}
+
+/// Keep non-empty index of type order in step with counter
+/// @param type Layer type
+- (void)updateOccupancyOfType:(NSString *)type {
+    id <ACStyleLayerCounter> counter = _counterMap[type];
+    [_typeOrder setType:type nonEmpty:counter && ![counter isEmpty]];
 }
 
 @end
@@ -0,0 +1,54 @@
+//
+//  ACStyleLayerTypeOrder.h
+//  ACSnippet
+//
+//  Created by Wenzhi WU on 19/10/2026.
+//  Copyright © 2026 Wenzhi WU. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// Order maintenance index of style layer types from bottom to top, each type holds an order label so two types
+/// compare in O(1), and non-empty types are kept sorted so the nearest non-empty type below is found in O(log n)
+@interface ACStyleLayerTypeOrder : NSObject
+
+/// Registered types from bottom to top
+@property (nonatomic, copy, readonly) NSArray <NSString *> *types;
+
+/// Designate initializer for ACStyleLayerTypeOrder object
+/// @param types Initial types from bottom to top
+- (instancetype)initWithTypes:(NSArray <NSString *> *)types;
+
+/// Whether type is registered
+/// @param type Layer type
+- (BOOL)containsType:(NSString *)type;
+
+/// Register type right above another type
+/// @param type New layer type
+/// @param above Registered layer type
+- (BOOL)addType:(NSString *)type aboveType:(NSString *)above;
+
+/// Register type right below another type
+/// @param type New layer type
+/// @param below Registered layer type
+- (BOOL)addType:(NSString *)type belowType:(NSString *)below;
+
+/// Compare position of two types, unregistered types are ordered above all registered types
+/// @param type Layer type
+/// @param other Layer type
+- (NSComparisonResult)compareType:(NSString *)type toType:(NSString *)other;
+
+/// Mark whether type currently holds layers
+/// @param type Registered layer type
+/// @param nonEmpty Whether type holds layers
+- (void)setType:(NSString *)type nonEmpty:(BOOL)nonEmpty;
+
+/// Nearest non-empty type strictly below type, the bottom type is returned for itself
+/// @param type Registered layer type
+- (nullable NSString *)nearestNonEmptyTypeBelowType:(NSString *)type;
+
+@end
+
+NS_ASSUME_NONNULL_END
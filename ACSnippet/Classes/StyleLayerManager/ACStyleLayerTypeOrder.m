@@ -0,0 +1,157 @@
+//
+//  ACStyleLayerTypeOrder.m
+//  ACSnippet
+//
+//  Created by Wenzhi WU on 19/10/2026.
+//  Copyright © 2026 Wenzhi WU. All rights reserved.
+//
+
+#import "ACStyleLayerTypeOrder.h"
+
+/// Gap between neighbour labels after relabeling, leaves room for 32 halvings before next relabel
+static const uint64_t ACStyleLayerTypeOrderSpacing = 1ULL << 32;
+
+@interface ACStyleLayerTypeOrder ()
+
+/// Types from bottom to top
+@property (nonatomic, strong) NSMutableArray <NSString *> *orderedTypes;
+
+/// Order label of type, increasing from bottom to top
+@property (nonatomic, strong) NSMutableDictionary <NSString *, NSNumber *> *labels;
+
+/// Non-empty types sorted by label
+@property (nonatomic, strong) NSMutableArray <NSString *> *nonEmptyTypes;
+
+/// Comparator by label
+@property (nonatomic, copy) NSComparator comparator;
+
+@end
+
+@implementation ACStyleLayerTypeOrder
+
+- (instancetype)init {
+    return [self initWithTypes:@[]];
+}
+
+- (instancetype)initWithTypes:(NSArray<NSString *> *)types {
+    self = [super init];
+    if (self) {
+        _orderedTypes = types.mutableCopy;
+        _labels = @{}.mutableCopy;
+        _nonEmptyTypes = @[].mutableCopy;
+        [self relabel];
+        
+        __weak typeof(self) _self = self;
+        _comparator = ^NSComparisonResult(NSString *obj1, NSString *obj2) {
+            return [_self compareType:obj1 toType:obj2];
+        };
+    }
+    
+    return self;
+}
+
+- (NSArray<NSString *> *)types {
+    return _orderedTypes.copy;
+}
+
+- (BOOL)containsType:(NSString *)type {
+    return _labels[type] != nil;
+}
+
+- (BOOL)addType:(NSString *)type aboveType:(NSString *)above {
+    if (!_labels[above] || _labels[type]) return NO;
+    
+    NSUInteger index = [self indexOfType:above];
+    [self insertType:type atIndex:index + 1];
+    return YES;
+}
+
+- (BOOL)addType:(NSString *)type belowType:(NSString *)below {
+    if (!_labels[below] || _labels[type]) return NO;
+    
+    NSUInteger index = [self indexOfType:below];
+    [self insertType:type atIndex:index];
+    return YES;
+}
+
+- (NSComparisonResult)compareType:(NSString *)type toType:(NSString *)other {
+    NSNumber *label = _labels[type];
+    NSNumber *otherLabel = _labels[other];
+    if (!label || !otherLabel) {
+        if (label) return NSOrderedAscending;
+        if (otherLabel) return NSOrderedDescending;
+        return NSOrderedSame;
+    }
+    
+    uint64_t value = label.unsignedLongLongValue;
+    uint64_t otherValue = otherLabel.unsignedLongLongValue;
+    return value < otherValue ? NSOrderedAscending : (value > otherValue ? NSOrderedDescending : NSOrderedSame);
+}
+
+- (void)setType:(NSString *)type nonEmpty:(BOOL)nonEmpty {
+    if (!_labels[type]) return;
+    
+    NSUInteger index = [self searchNonEmptyType:type options:NSBinarySearchingFirstEqual];
+    if (nonEmpty && index == NSNotFound) {
+        index = [self searchNonEmptyType:type options:NSBinarySearchingInsertionIndex];
+        [_nonEmptyTypes insertObject:type atIndex:index];
+    } else if (!nonEmpty && index != NSNotFound) {
+        [_nonEmptyTypes removeObjectAtIndex:index];
+    }
+}
+
+- (NSString *)nearestNonEmptyTypeBelowType:(NSString *)type {
+    if (!_labels[type]) return nil;
+    if ([type isEqualToString:_orderedTypes.firstObject]) return type;
+    
+    // insertion index before equal element, so the element ahead of it is strictly below
+    NSUInteger index = [self searchNonEmptyType:type options:NSBinarySearchingInsertionIndex | NSBinarySearchingFirstEqual];
+    return index > 0 ? _nonEmptyTypes[index - 1] : nil;
+}
+
+#pragma mark - Private
+/// Position of registered type, ordered types are sorted by label so it is found by binary search
+- (NSUInteger)indexOfType:(NSString *)type {
+    return [_orderedTypes indexOfObject:type
+                          inSortedRange:NSMakeRange(0, _orderedTypes.count)
+                                options:NSBinarySearchingFirstEqual
+                        usingComparator:_comparator];
+}
+
+- (NSUInteger)searchNonEmptyType:(NSString *)type options:(NSBinarySearchingOptions)options {
+    return [_nonEmptyTypes indexOfObject:type
+                           inSortedRange:NSMakeRange(0, _nonEmptyTypes.count)
+                                 options:options
+                         usingComparator:_comparator];
+}
+
+/// Insert type and take the middle label of its neighbours, relabel all types when the gap is used up
+/// @param type New layer type
+/// @param index Position in ordered types
+- (void)insertType:(NSString *)type atIndex:(NSUInteger)index {
+    [_orderedTypes insertObject:type atIndex:index];
+    
+    uint64_t lower = index > 0 ? _labels[_orderedTypes[index - 1]].unsignedLongLongValue : 0;
+    if (index + 1 >= _orderedTypes.count) {
+        if (UINT64_MAX - lower > ACStyleLayerTypeOrderSpacing) {
+            [_labels setObject:@(lower + ACStyleLayerTypeOrderSpacing) forKey:type];
+            return;
+        }
+    } else {
+        uint64_t upper = _labels[_orderedTypes[index + 1]].unsignedLongLongValue;
+        if (upper - lower > 1) {
+            [_labels setObject:@(lower + (upper - lower) / 2) forKey:type];
+            return;
+        }
+    }
+    
+    [self relabel];
+}
+
+- (void)relabel {
+    [_orderedTypes enumerateObjectsUsingBlock:^(NSString *obj, NSUInteger idx, BOOL *stop) {
+        [self.labels setObject:@((idx + 1) * ACStyleLayerTypeOrderSpacing) forKey:obj];
+    }];
+}
+
+@end
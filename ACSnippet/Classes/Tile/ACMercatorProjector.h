@@ -39,6 +39,15 @@ NS_ASSUME_NONNULL_BEGIN
 /// @param coordinate Location coordinate
 - (CGPoint)tileXYWithZoom:(NSUInteger)zoom atCoordinate:(CLLocationCoordinate2D)coordinate;
 
+/// Get fractional tile x/y under Google schema, integer part is the tile index and fraction is the offset within tile
+/// @param zoom Zoom level
+/// @param coordinate Location coordinate
+- (CGPoint)tilePointWithZoom:(NSUInteger)zoom atCoordinate:(CLLocationCoordinate2D)coordinate;
+
+/// Get tile edge length in Spherical Mercator meters with zoom level
+/// @param zoom Zoom level
+- (CLLocationDistance)tileSpanInMetersWithZoom:(NSUInteger)zoom;
+
 /// Get tile formatted code zoom/x/y with zoom, x, y input
 /// @param zoom Zoom level
 /// @param x Tile in x index
@@ -156,6 +156,25 @@ typedef struct ACBoundingBox ACBoundingBox;
     return tileXY;
 }
 
+- (CGPoint)tilePointWithZoom:(NSUInteger)zoom atCoordinate:(CLLocationCoordinate2D)coordinate {
+    if (!CLLocationCoordinate2DIsValid(coordinate)) {
+        NSLog(@"ACMercatorProjector[%@]: invalid coordinate input", NSStringFromSelector(_cmd));
+        return CGPointMake(-1, -1);
+    }
+    
+    CGPoint meters = [self coordinateToMeters:coordinate];
+    CGPoint pixel = [self metersToPixels:meters inZoom:zoom];
+    CGFloat x = pixel.x / (CGFloat)_tileSize;
+    
+    // pixel y is under TMS, flip to Google
+    CGFloat y = pow(2, zoom) - pixel.y / (CGFloat)_tileSize;
+    return CGPointMake(x, y);
+}
+
+- (CLLocationDistance)tileSpanInMetersWithZoom:(NSUInteger)zoom {
+    return [self resolutionInZoom:zoom] * _tileSize;
+}
+
 - (ACTileRegion *)tileWithZoom:(NSUInteger)zoom atCoordinate:(CLLocationCoordinate2D)coordinate {
     if (!CLLocationCoordinate2DIsValid(coordinate)) {
         NSLog(@"ACMercatorProjector[%@]: invalid coordinate input", NSStringFromSelector(_cmd));
@@ -0,0 +1,74 @@
+//
+//  ACTileKey.h
+//  ACSnippet
+//
+//  Created by Wenzhi WU on 19/10/2026.
+//  Copyright © 2026 Wenzhi WU. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// A packed 64-bit tile identity under Google schema
+///
+/// Layout (most significant bit first):
+///    zoom:
+///        5 bits, zoom level 0 ~ 29
+///    x:
+///        29 bits, tile column
+///    y:
+///        29 bits, tile row
+///
+/// Keys of same zoom sort by x then y, which keeps scanline output in order
+typedef uint64_t ACTileKey;
+
+/// Maximum zoom level a tile key is able to hold
+extern const NSUInteger ACTileKeyMaximumZoom;
+
+/// Invalid tile key, returned when input is out of range
+extern const ACTileKey ACTileKeyInvalid;
+
+/// Designate initializer for ACTileKey
+/// @param zoom Zoom level
+/// @param x Tile x index
+/// @param y Tile y index
+ACTileKey ACTileKeyMake(NSUInteger zoom, NSUInteger x, NSUInteger y);
+
+/// Parse tile code in x/y/zoom format without intermediate allocations,
+/// ACTileKeyInvalid is returned for malformed or out of range code
+/// @param tileCode Tile code
+ACTileKey ACTileKeyFromTileCode(NSString * _Nullable tileCode);
+
+/// Zoom level of tile key
+/// @param key Tile key
+NSUInteger ACTileKeyZoom(ACTileKey key);
+
+/// Tile x index of tile key
+/// @param key Tile key
+NSUInteger ACTileKeyX(ACTileKey key);
+
+/// Tile y index of tile key
+/// @param key Tile key
+NSUInteger ACTileKeyY(ACTileKey key);
+
+/// Parent tile key in one lower zoom level, zoom 0 tile returns ACTileKeyInvalid
+/// @param key Tile key
+ACTileKey ACTileKeyParent(ACTileKey key);
+
+/// Ancestor tile key in given lower zoom level
+/// @param key Tile key
+/// @param zoom Ancestor zoom level, should not greater than key zoom
+ACTileKey ACTileKeyAncestor(ACTileKey key, NSUInteger zoom);
+
+/// Fill the four child tile keys in one higher zoom level, ordered NW, SW, NE, SE
+/// @param key Tile key
+/// @param children Output buffer for 4 keys
+void ACTileKeyChildren(ACTileKey key, ACTileKey children[_Nonnull 4]);
+
+/// Check if tile key is ancestor of another or the same tile
+/// @param ancestor Ancestor tile key
+/// @param key Descendant tile key
+BOOL ACTileKeyIsAncestorOf(ACTileKey ancestor, ACTileKey key);
+
+NS_ASSUME_NONNULL_END
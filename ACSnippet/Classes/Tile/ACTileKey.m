@@ -0,0 +1,103 @@
+//
+//  ACTileKey.m
+//  ACSnippet
+//
+//  Created by Wenzhi WU on 19/10/2026.
+//  Copyright © 2026 Wenzhi WU. All rights reserved.
+//
+
+#import "ACTileKey.h"
+
+#define AC_TILE_KEY_AXIS_BITS   29
+#define AC_TILE_KEY_AXIS_MASK   ((1ULL << AC_TILE_KEY_AXIS_BITS) - 1)
+
+const NSUInteger ACTileKeyMaximumZoom = AC_TILE_KEY_AXIS_BITS;
+const ACTileKey ACTileKeyInvalid = UINT64_MAX;
+
+ACTileKey ACTileKeyMake(NSUInteger zoom, NSUInteger x, NSUInteger y) {
+    if (zoom > ACTileKeyMaximumZoom) return ACTileKeyInvalid;
+    
+    uint64_t max = 1ULL << zoom;
+    if (x >= max || y >= max) return ACTileKeyInvalid;
+
+    return ((uint64_t)zoom << (AC_TILE_KEY_AXIS_BITS * 2)) | ((uint64_t)x << AC_TILE_KEY_AXIS_BITS) | (uint64_t)y;
+}
+
+ACTileKey ACTileKeyFromTileCode(NSString *tileCode) {
+    CFStringRef string = (__bridge CFStringRef)tileCode;
+    CFIndex length = string ? CFStringGetLength(string) : 0;
+    if (length == 0) return ACTileKeyInvalid;
+    
+    CFStringInlineBuffer buffer;
+    CFStringInitInlineBuffer(string, &buffer, CFRangeMake(0, length));
+    
+    // x, y, zoom
+    uint64_t parts[3] = {0, 0, 0};
+    NSUInteger part = 0;
+    NSUInteger digits = 0;
+    for (CFIndex i = 0; i < length; i++) {
+        UniChar c = CFStringGetCharacterFromInlineBuffer(&buffer, i);
+        if (c >= '0' && c <= '9') {
+            if (++digits > 10) return ACTileKeyInvalid;
+            parts[part] = parts[part] * 10 + (c - '0');
+        } else if (c == '/' && digits > 0 && part < 2) {
+            part++;
+            digits = 0;
+        } else {
+            return ACTileKeyInvalid;
+        }
+    }
+    
+    if (part != 2 || digits == 0) return ACTileKeyInvalid;
+    return ACTileKeyMake((NSUInteger)parts[2], (NSUInteger)parts[0], (NSUInteger)parts[1]);
+}
+
+NSUInteger ACTileKeyZoom(ACTileKey key) {
+    return (NSUInteger)(key >> (AC_TILE_KEY_AXIS_BITS * 2));
+}
+
+NSUInteger ACTileKeyX(ACTileKey key) {
+    return (NSUInteger)((key >> AC_TILE_KEY_AXIS_BITS) & AC_TILE_KEY_AXIS_MASK);
+}
+
+NSUInteger ACTileKeyY(ACTileKey key) {
+    return (NSUInteger)(key & AC_TILE_KEY_AXIS_MASK);
+}
+
+ACTileKey ACTileKeyParent(ACTileKey key) {
+    if (key == ACTileKeyInvalid) return ACTileKeyInvalid;
+
+    NSUInteger zoom = ACTileKeyZoom(key);
+    if (zoom == 0) return ACTileKeyInvalid;
+    return ACTileKeyMake(zoom - 1, ACTileKeyX(key) >> 1, ACTileKeyY(key) >> 1);
+}
+
+ACTileKey ACTileKeyAncestor(ACTileKey key, NSUInteger zoom) {
+    if (key == ACTileKeyInvalid) return ACTileKeyInvalid;
+
+    NSUInteger current = ACTileKeyZoom(key);
+    if (zoom > current) return ACTileKeyInvalid;
+
+    NSUInteger shift = current - zoom;
+    return ACTileKeyMake(zoom, ACTileKeyX(key) >> shift, ACTileKeyY(key) >> shift);
+}
+
+void ACTileKeyChildren(ACTileKey key, ACTileKey children[4]) {
+    NSUInteger zoom = ACTileKeyZoom(key);
+    if (key == ACTileKeyInvalid || zoom >= ACTileKeyMaximumZoom) {
+        children[0] = children[1] = children[2] = children[3] = ACTileKeyInvalid;
+        return;
+    }
+
+    NSUInteger x = ACTileKeyX(key) << 1;
+    NSUInteger y = ACTileKeyY(key) << 1;
+    children[0] = ACTileKeyMake(zoom + 1, x, y);
+    children[1] = ACTileKeyMake(zoom + 1, x, y + 1);
+    children[2] = ACTileKeyMake(zoom + 1, x + 1, y);
+    children[3] = ACTileKeyMake(zoom + 1, x + 1, y + 1);
+}
+
+BOOL ACTileKeyIsAncestorOf(ACTileKey ancestor, ACTileKey key) {
+    if (ancestor == ACTileKeyInvalid || key == ACTileKeyInvalid) return NO;
+    return ACTileKeyAncestor(key, ACTileKeyZoom(ancestor)) == ancestor;
+}
@@ -10,11 +10,30 @@
 #import <CoreLocation/CoreLocation.h>
 #import "ACTileRegion.h"
 #import "ACTileCollection.h"
+#import "ACTileKey.h"
+#import "ACTileRegionCache.h"
 
 NS_ASSUME_NONNULL_BEGIN
 
+@class ACTileViewportTracker;
+
+/// Multi-zoom coverage output options
+///
+/// Values:
+///    ACTileCoveragePyramid:
+///        Every zoom level in range is fully covered, tiles of lower zoom are ancestors of higher zoom tiles
+///    ACTileCoverageQuadtree:
+///        Mixed zoom cover, four sibling tiles that are all covered are merged into their parent down to minimum zoom
+typedef NS_ENUM(NSInteger, ACTileCoverage) {
+    ACTileCoveragePyramid,
+    ACTileCoverageQuadtree
+};
+
 @interface ACTileManager : NSObject
 
+/// Flyweight cache of tile regions returned by manager, inspect it for hit rate and allocation counts
+@property (nonatomic, strong, readonly) ACTileRegionCache   *regionCache;
+
 /// Get shared instance for ACTilesManager object
 + (instancetype)sharedManager;
 
@@ -34,6 +53,11 @@ NS_ASSUME_NONNULL_BEGIN
 /// @param zoom Zoom level
 /// @param coordinate Location coordinate
 - (NSString *)tileCodeWithZoom:(NSUInteger)zoom atCoordinate:(CLLocationCoordinate2D)coordinate;
+
+/// Get fractional tile x/y for coordinate at zoom level, integer part is the tile index
+/// @param zoom Zoom level
+/// @param coordinate Location coordinate
+- (CGPoint)tilePointWithZoom:(NSUInteger)zoom atCoordinate:(CLLocationCoordinate2D)coordinate;
     
 /// Get tile under certain zoom level and location coordinate,
 /// Tile x, y are calculated under Google schema (not TMS)
@@ -85,6 +109,61 @@ NS_ASSUME_NONNULL_BEGIN
 /// @param zoom Zoom level
 - (NSArray <ACTileRegion *>*)tilesFrom:(CGPoint)fromXY to:(CGPoint)toXY withZoom:(NSUInteger)zoom;
 
+/// Get packed tile key for tile code, ACTileKeyInvalid is returned for invalid code
+/// @param tileCode Tile code
+- (ACTileKey)tileKeyWithTileCode:(NSString *)tileCode;
+
+/// Get tile code for packed tile key
+/// @param key Tile key
+- (nullable NSString *)tileCodeWithTileKey:(ACTileKey)key;
+
+/// Get parent tile code in one lower zoom level
+/// @param tileCode Tile code
+- (nullable NSString *)parentTileCodeOfTileCode:(NSString *)tileCode;
+
+/// Get ancestor tile code in lower zoom level
+/// @param tileCode Tile code
+/// @param zoom Ancestor zoom level
+- (nullable NSString *)ancestorTileCodeOfTileCode:(NSString *)tileCode atZoom:(NSUInteger)zoom;
+
+/// Get four child tile codes in one higher zoom level
+/// @param tileCode Tile code
+- (NSArray <NSString *>*)childTileCodesOfTileCode:(NSString *)tileCode;
+
+/// Get minimal tile codes covering polygon at zoom level, tiles touched by edges or inside the ring are included
+/// @param zoom Zoom level
+/// @param coordinates Polygon vertices, closing vertex is optional, nothing is covered if any vertex is invalid
+/// @param count Vertex count
+- (NSArray <NSString *>*)tileCodesWithZoom:(NSUInteger)zoom coveringPolygonCoordinates:(const CLLocationCoordinate2D *)coordinates count:(NSUInteger)count;
+
+/// Get minimal tile codes covering polyline with buffer distance at zoom level, e.g. navigation route
+/// @param zoom Zoom level
+/// @param coordinates Polyline vertices, nothing is covered if any vertex is invalid
+/// @param count Vertex count
+/// @param distance Buffer distance in meters on both sides of polyline
+- (NSArray <NSString *>*)tileCodesWithZoom:(NSUInteger)zoom coveringPolylineCoordinates:(const CLLocationCoordinate2D *)coordinates count:(NSUInteger)count bufferDistance:(CLLocationDistance)distance;
+
+/// Get tile codes covering polygon from minimum zoom to maximum zoom
+/// @param minZoom Minimum zoom level
+/// @param maxZoom Maximum zoom level
+/// @param coverage Pyramid or quadtree output
+/// @param coordinates Polygon vertices, closing vertex is optional, nothing is covered if any vertex is invalid
+/// @param count Vertex count
+- (NSArray <NSString *>*)tileCodesFromZoom:(NSUInteger)minZoom toZoom:(NSUInteger)maxZoom coverage:(ACTileCoverage)coverage coveringPolygonCoordinates:(const CLLocationCoordinate2D *)coordinates count:(NSUInteger)count;
+
+/// Get tile codes covering polyline with buffer distance from minimum zoom to maximum zoom
+/// @param minZoom Minimum zoom level
+/// @param maxZoom Maximum zoom level
+/// @param coverage Pyramid or quadtree output
+/// @param coordinates Polyline vertices, nothing is covered if any vertex is invalid
+/// @param count Vertex count
+/// @param distance Buffer distance in meters on both sides of polyline
+- (NSArray <NSString *>*)tileCodesFromZoom:(NSUInteger)minZoom toZoom:(NSUInteger)maxZoom coverage:(ACTileCoverage)coverage coveringPolylineCoordinates:(const CLLocationCoordinate2D *)coordinates count:(NSUInteger)count bufferDistance:(CLLocationDistance)distance;
+
+/// Create a viewport tracker that turns camera updates into coalesced tile changes
+/// @param dimension Odd number described viewport range
+- (ACTileViewportTracker *)viewportTrackerWithDimension:(NSUInteger)dimension;
+
 
 @end
 
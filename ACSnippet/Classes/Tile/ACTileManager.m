@@ -8,6 +8,7 @@
 
 #import "ACTileManager.h"
 #import "ACMercatorProjector.h"
+#import "ACTileViewportTracker.h"
 
 @interface ACTileManager ()
 
@@ -17,6 +18,213 @@
 @end
 
 
+/// A growable buffer of tile keys used by coverage queries
+///
+/// Fields:
+///    keys:
+///        Key storage
+///    count:
+///        Number of keys in storage
+///    capacity:
+///        Allocated key slots
+struct ACTileKeyBuffer {
+    ACTileKey   *keys;
+    NSUInteger  count;
+    NSUInteger  capacity;
+};
+typedef struct ACTileKeyBuffer ACTileKeyBuffer;
+
+/// Append tile key to buffer
+/// @param buffer Key buffer
+/// @param key Tile key
+static void ACTileKeyBufferAppend(ACTileKeyBuffer *buffer, ACTileKey key) {
+    if (key == ACTileKeyInvalid) return;
+    if (buffer->count == buffer->capacity) {
+        buffer->capacity = MAX(64, buffer->capacity * 2);
+        buffer->keys = realloc(buffer->keys, buffer->capacity * sizeof(ACTileKey));
+    }
+    
+    buffer->keys[buffer->count++] = key;
+}
+
+static int ACTileKeyCompare(const void *lh, const void *rh) {
+    ACTileKey left = *(const ACTileKey *)lh;
+    ACTileKey right = *(const ACTileKey *)rh;
+    return left < right ? -1 : (left > right ? 1 : 0);
+}
+
+static int ACTileKeyCompareByParent(const void *lh, const void *rh) {
+    ACTileKey left = ACTileKeyParent(*(const ACTileKey *)lh);
+    ACTileKey right = ACTileKeyParent(*(const ACTileKey *)rh);
+    if (left != right) return left < right ? -1 : 1;
+    return ACTileKeyCompare(lh, rh);
+}
+
+/// Sort keys in buffer and drop duplicates
+/// @param buffer Key buffer
+static void ACTileKeyBufferSortUnique(ACTileKeyBuffer *buffer) {
+    if (buffer->count < 2) return;
+    
+    qsort(buffer->keys, buffer->count, sizeof(ACTileKey), ACTileKeyCompare);
+    NSUInteger unique = 1;
+    for (NSUInteger i = 1; i < buffer->count; i++) {
+        if (buffer->keys[i] == buffer->keys[unique - 1]) continue;
+        buffer->keys[unique++] = buffer->keys[i];
+    }
+    buffer->count = unique;
+}
+
+/// Clamp fractional tile point into world bounds at zoom level, upper bound is the largest value below
+/// world size so its floor stays on the last tile at any zoom
+/// @param point Fractional tile x/y
+/// @param zoom Zoom level
+static CGPoint ACTilePointClamp(CGPoint point, NSUInteger zoom) {
+    CGFloat max = nextafter((CGFloat)(1ULL << zoom), 0);
+    point.x = MIN(MAX(point.x, 0), max);
+    point.y = MIN(MAX(point.y, 0), max);
+    return point;
+}
+
+/// Append every tile the segment passes through by grid traversal
+/// @param from Segment start in fractional tile x/y
+/// @param to Segment end in fractional tile x/y
+/// @param zoom Zoom level
+/// @param buffer Output key buffer
+static void ACTileRasterizeSegment(CGPoint from, CGPoint to, NSUInteger zoom, ACTileKeyBuffer *buffer) {
+    from = ACTilePointClamp(from, zoom);
+    to = ACTilePointClamp(to, zoom);
+    
+    NSInteger x = (NSInteger)floor(from.x);
+    NSInteger y = (NSInteger)floor(from.y);
+    NSInteger endX = (NSInteger)floor(to.x);
+    NSInteger endY = (NSInteger)floor(to.y);
+    
+    CGFloat dx = to.x - from.x;
+    CGFloat dy = to.y - from.y;
+    NSInteger stepX = dx > 0 ? 1 : (dx < 0 ? -1 : 0);
+    NSInteger stepY = dy > 0 ? 1 : (dy < 0 ? -1 : 0);
+    CGFloat deltaX = stepX ? fabs(1.0 / dx) : DBL_MAX;
+    CGFloat deltaY = stepY ? fabs(1.0 / dy) : DBL_MAX;
+    CGFloat nextX = stepX > 0 ? (x + 1 - from.x) / dx : (stepX < 0 ? (from.x - x) / -dx : DBL_MAX);
+    CGFloat nextY = stepY > 0 ? (y + 1 - from.y) / dy : (stepY < 0 ? (from.y - y) / -dy : DBL_MAX);
+    
+    ACTileKeyBufferAppend(buffer, ACTileKeyMake(zoom, x, y));
+    NSUInteger steps = labs(endX - x) + labs(endY - y);
+    while (steps-- > 0) {
+        if (nextX < nextY) {
+            nextX += deltaX;
+            x += stepX;
+        } else {
+            nextY += deltaY;
+            y += stepY;
+        }
+        
+        ACTileKeyBufferAppend(buffer, ACTileKeyMake(zoom, x, y));
+    }
+}
+
+/// Append tiles covering polygon, boundary tiles come from edge traversal and interior tiles from center scanlines
+/// @param points Polygon vertices in fractional tile x/y
+/// @param count Vertex count
+/// @param zoom Zoom level
+/// @param buffer Output key buffer
+static void ACTileRasterizePolygon(const CGPoint *points, NSUInteger count, NSUInteger zoom, ACTileKeyBuffer *buffer) {
+    if (count == 0) return;
+    
+    CGFloat minY = DBL_MAX, maxY = -DBL_MAX;
+    for (NSUInteger i = 0; i < count; i++) {
+        ACTileRasterizeSegment(points[i], points[(i + 1) % count], zoom, buffer);
+        minY = MIN(minY, points[i].y);
+        maxY = MAX(maxY, points[i].y);
+    }
+    
+    if (count < 3) return;
+    
+    NSInteger max = (NSInteger)(1ULL << zoom) - 1;
+    NSInteger fromRow = MAX(0, (NSInteger)floor(minY));
+    NSInteger toRow = MIN(max, (NSInteger)floor(maxY));
+    CGFloat *crossings = malloc(count * sizeof(CGFloat));
+    for (NSInteger row = fromRow; row <= toRow; row++) {
+        CGFloat scanY = row + 0.5;
+        NSUInteger found = 0;
+        for (NSUInteger i = 0; i < count; i++) {
+            CGPoint a = points[i];
+            CGPoint b = points[(i + 1) % count];
+            if ((a.y <= scanY && b.y > scanY) || (b.y <= scanY && a.y > scanY)) {
+                crossings[found++] = a.x + (scanY - a.y) / (b.y - a.y) * (b.x - a.x);
+            }
+        }
+        
+        // insertion sort, crossings per row are few
+        for (NSUInteger i = 1; i < found; i++) {
+            CGFloat value = crossings[i];
+            NSUInteger j = i;
+            while (j > 0 && crossings[j - 1] > value) {
+                crossings[j] = crossings[j - 1];
+                j--;
+            }
+            crossings[j] = value;
+        }
+        
+        for (NSUInteger i = 0; i + 1 < found; i += 2) {
+            NSInteger fromX = MAX(0, (NSInteger)ceil(crossings[i] - 0.5));
+            NSInteger toX = MIN(max, (NSInteger)floor(crossings[i + 1] - 0.5));
+            for (NSInteger x = fromX; x <= toX; x++) {
+                ACTileKeyBufferAppend(buffer, ACTileKeyMake(zoom, x, row));
+            }
+        }
+    }
+    free(crossings);
+}
+
+/// Replace buffer content with unique parent keys of its content
+/// @param buffer Key buffer holding keys of single zoom level
+static void ACTileKeyBufferPromote(ACTileKeyBuffer *buffer) {
+    for (NSUInteger i = 0; i < buffer->count; i++) {
+        buffer->keys[i] = ACTileKeyParent(buffer->keys[i]);
+    }
+    ACTileKeyBufferSortUnique(buffer);
+}
+
+/// Merge complete sibling groups into their parents down to minimum zoom, remaining keys are moved to output
+/// @param level Unique keys of single zoom level, freed after merging
+/// @param zoom Zoom level of keys in level buffer
+/// @param minZoom Minimum zoom level
+/// @param output Output key buffer
+static void ACTileKeyBufferMergeSiblings(ACTileKeyBuffer *level, NSUInteger zoom, NSUInteger minZoom, ACTileKeyBuffer *output) {
+    while (zoom > minZoom && level->count) {
+        qsort(level->keys, level->count, sizeof(ACTileKey), ACTileKeyCompareByParent);
+        
+        ACTileKeyBuffer parents = {0};
+        NSUInteger i = 0;
+        while (i < level->count) {
+            ACTileKey parent = ACTileKeyParent(level->keys[i]);
+            NSUInteger j = i;
+            while (j < level->count && ACTileKeyParent(level->keys[j]) == parent) j++;
+            
+            if (j - i == 4) {
+                ACTileKeyBufferAppend(&parents, parent);
+            } else {
+                for (NSUInteger k = i; k < j; k++) {
+                    ACTileKeyBufferAppend(output, level->keys[k]);
+                }
+            }
+            i = j;
+        }
+        
+        free(level->keys);
+        *level = parents;
+        zoom--;
+    }
+    
+    for (NSUInteger i = 0; i < level->count; i++) {
+        ACTileKeyBufferAppend(output, level->keys[i]);
+    }
+    free(level->keys);
+    *level = (ACTileKeyBuffer){0};
+}
+
+
 @implementation ACTileManager
 
 + (instancetype)sharedManager {
@@ -38,6 +246,7 @@
     if (self) {
         NSUInteger tileSize = high ? 512 : 256;
         _projector = [[ACMercatorProjector alloc] initWithTileSize:tileSize];
+        _regionCache = [[ACTileRegionCache alloc] initWithCapacity:1024];
     }
     return self;
 }
@@ -55,21 +264,28 @@
     return [_projector tileCodeWithZoom:zoom x:tileXY.x y:tileXY.y];
 }
 
+- (CGPoint)tilePointWithZoom:(NSUInteger)zoom atCoordinate:(CLLocationCoordinate2D)coordinate {
+    return [_projector tilePointWithZoom:zoom atCoordinate:coordinate];
+}
+
 - (ACTileRegion *)tileWithZoom:(NSUInteger)zoom atCoordinate:(CLLocationCoordinate2D)coordinate {
-    return [_projector tileWithZoom:zoom atCoordinate:coordinate];
+    if (!CLLocationCoordinate2DIsValid(coordinate)) {
+        NSLog(@"ACTileManager: invalid coordinate input");
+        return nil;
+    }
+    
+    CGPoint tileXY = [_projector tileXYWithZoom:zoom atCoordinate:coordinate];
+    return [self tileWithZoom:zoom x:tileXY.x y:tileXY.y];
 }
 
 - (ACTileRegion *)tileWithTileCode:(NSString *)tileCode {
-    NSArray *components = [tileCode componentsSeparatedByString:@"/"];
-    if ([components count] < 3) {
+    ACTileKey key = ACTileKeyFromTileCode(tileCode);
+    if (key == ACTileKeyInvalid) {
         NSLog(@"ACTileManager: Invalid tile code %@", tileCode);
         return nil;
     }
     
-    NSUInteger x = [components[0] integerValue];
-    NSUInteger y = [components[1] integerValue];
-    NSUInteger zoom = [components[2] integerValue];
-    return [_projector tileWithZoom:zoom x:x y:y];
+    return [self tileWithTileKey:key];
 }
 
 - (NSString *)tileCodeWithZoom:(NSUInteger)zoom x:(NSUInteger)x y:(NSUInteger)y {
@@ -77,7 +293,24 @@
 }
 
 - (ACTileRegion *)tileWithZoom:(NSUInteger)zoom x:(NSUInteger)x y:(NSUInteger)y {
-    return [_projector tileWithZoom:zoom x:x y:y];
+    ACTileKey key = ACTileKeyMake(zoom, x, y);
+    if (key == ACTileKeyInvalid) {
+        // out of range x is wrapped and invalid y is rejected by projector
+        return [_projector tileWithZoom:zoom x:x y:y];
+    }
+    
+    return [self tileWithTileKey:key];
+}
+
+/// Get shared tile region for tile key, region is only created on cache miss
+/// @param key Tile key
+- (ACTileRegion *)tileWithTileKey:(ACTileKey)key {
+    ACTileRegion *region = [_regionCache regionForKey:key];
+    if (region) return region;
+    
+    region = [_projector tileWithZoom:ACTileKeyZoom(key) x:ACTileKeyX(key) y:ACTileKeyY(key)];
+    if (!region) return nil;
+    return [_regionCache storeRegion:region forKey:key];
 }
 
 - (ACTileCollection *)tileCollectionWithZoom:(NSUInteger)zoom atCoordinate:(CLLocationCoordinate2D)coordinate withDimension:(NSUInteger)dimension {
@@ -147,4 +380,209 @@
     return mutable.copy;
 }
 
+- (ACTileViewportTracker *)viewportTrackerWithDimension:(NSUInteger)dimension {
+    return [[ACTileViewportTracker alloc] initWithTileManager:self dimension:dimension];
+}
+
+#pragma mark - Tile Key
+- (ACTileKey)tileKeyWithTileCode:(NSString *)tileCode {
+    return ACTileKeyFromTileCode(tileCode);
+}
+
+- (NSString *)tileCodeWithTileKey:(ACTileKey)key {
+    if (key == ACTileKeyInvalid) return nil;
+    return [_projector tileCodeWithZoom:ACTileKeyZoom(key) x:ACTileKeyX(key) y:ACTileKeyY(key)];
+}
+
+- (NSString *)parentTileCodeOfTileCode:(NSString *)tileCode {
+    return [self tileCodeWithTileKey:ACTileKeyParent([self tileKeyWithTileCode:tileCode])];
+}
+
+- (NSString *)ancestorTileCodeOfTileCode:(NSString *)tileCode atZoom:(NSUInteger)zoom {
+    return [self tileCodeWithTileKey:ACTileKeyAncestor([self tileKeyWithTileCode:tileCode], zoom)];
+}
+
+- (NSArray <NSString *>*)childTileCodesOfTileCode:(NSString *)tileCode {
+    ACTileKey children[4];
+    ACTileKeyChildren([self tileKeyWithTileCode:tileCode], children);
+    
+    NSMutableArray *mutable = @[].mutableCopy;
+    for (int i = 0; i < 4; i++) {
+        NSString *code = [self tileCodeWithTileKey:children[i]];
+        if (code) {
+            [mutable addObject:code];
+        }
+    }
+    
+    return mutable.copy;
+}
+
+/// Convert tile keys in buffer to tile codes, buffer is freed after converting
+/// @param buffer Key buffer
+- (NSArray <NSString *>*)tileCodesWithKeyBuffer:(ACTileKeyBuffer *)buffer {
+    ACTileKeyBufferSortUnique(buffer);
+    
+    NSMutableArray *mutable = [NSMutableArray arrayWithCapacity:buffer->count];
+    for (NSUInteger i = 0; i < buffer->count; i++) {
+        [mutable addObject:[self tileCodeWithTileKey:buffer->keys[i]]];
+    }
+    
+    free(buffer->keys);
+    *buffer = (ACTileKeyBuffer){0};
+    return mutable.copy;
+}
+
+#pragma mark - Coverage
+- (NSArray <NSString *>*)tileCodesWithZoom:(NSUInteger)zoom coveringPolygonCoordinates:(const CLLocationCoordinate2D *)coordinates count:(NSUInteger)count {
+    ACTileKeyBuffer buffer = {0};
+    [self rasterizePolygonCoordinates:coordinates count:count withZoom:zoom intoBuffer:&buffer];
+    return [self tileCodesWithKeyBuffer:&buffer];
+}
+
+- (NSArray <NSString *>*)tileCodesWithZoom:(NSUInteger)zoom coveringPolylineCoordinates:(const CLLocationCoordinate2D *)coordinates count:(NSUInteger)count bufferDistance:(CLLocationDistance)distance {
+    ACTileKeyBuffer buffer = {0};
+    [self rasterizePolylineCoordinates:coordinates count:count bufferDistance:distance withZoom:zoom intoBuffer:&buffer];
+    return [self tileCodesWithKeyBuffer:&buffer];
+}
+
+- (NSArray <NSString *>*)tileCodesFromZoom:(NSUInteger)minZoom toZoom:(NSUInteger)maxZoom coverage:(ACTileCoverage)coverage coveringPolygonCoordinates:(const CLLocationCoordinate2D *)coordinates count:(NSUInteger)count {
+    if (minZoom > maxZoom) {
+        NSLog(@"ACTileManager: invalid zoom range %@ ~ %@", @(minZoom), @(maxZoom));
+        return @[];
+    }
+    
+    ACTileKeyBuffer level = {0};
+    [self rasterizePolygonCoordinates:coordinates count:count withZoom:maxZoom intoBuffer:&level];
+    return [self tileCodesWithLevelBuffer:&level zoom:maxZoom minZoom:minZoom coverage:coverage];
+}
+
+- (NSArray <NSString *>*)tileCodesFromZoom:(NSUInteger)minZoom toZoom:(NSUInteger)maxZoom coverage:(ACTileCoverage)coverage coveringPolylineCoordinates:(const CLLocationCoordinate2D *)coordinates count:(NSUInteger)count bufferDistance:(CLLocationDistance)distance {
+    if (minZoom > maxZoom) {
+        NSLog(@"ACTileManager: invalid zoom range %@ ~ %@", @(minZoom), @(maxZoom));
+        return @[];
+    }
+    
+    ACTileKeyBuffer level = {0};
+    [self rasterizePolylineCoordinates:coordinates count:count bufferDistance:distance withZoom:maxZoom intoBuffer:&level];
+    return [self tileCodesWithLevelBuffer:&level zoom:maxZoom minZoom:minZoom coverage:coverage];
+}
+
+/// Build multi-zoom output from cover of the highest zoom level, cover of lower zoom is the parents of higher zoom cover
+/// @param level Key buffer of highest zoom cover, freed after building
+/// @param zoom Highest zoom level
+/// @param minZoom Minimum zoom level
+/// @param coverage Pyramid or quadtree output
+- (NSArray <NSString *>*)tileCodesWithLevelBuffer:(ACTileKeyBuffer *)level zoom:(NSUInteger)zoom minZoom:(NSUInteger)minZoom coverage:(ACTileCoverage)coverage {
+    ACTileKeyBufferSortUnique(level);
+    
+    ACTileKeyBuffer output = {0};
+    if (coverage == ACTileCoverageQuadtree) {
+        ACTileKeyBufferMergeSiblings(level, zoom, minZoom, &output);
+    } else {
+        while (level->count) {
+            for (NSUInteger i = 0; i < level->count; i++) {
+                ACTileKeyBufferAppend(&output, level->keys[i]);
+            }
+            
+            if (zoom == minZoom) break;
+            ACTileKeyBufferPromote(level);
+            zoom--;
+        }
+        free(level->keys);
+        *level = (ACTileKeyBuffer){0};
+    }
+    
+    return [self tileCodesWithKeyBuffer:&output];
+}
+
+/// Check every vertex before rasterizing, projector maps an invalid one to a sentinel point that would add spurious edges
+/// @param coordinates Vertices
+/// @param count Vertex count
+- (BOOL)validateCoordinates:(const CLLocationCoordinate2D *)coordinates count:(NSUInteger)count {
+    for (NSUInteger i = 0; i < count; i++) {
+        if (!CLLocationCoordinate2DIsValid(coordinates[i])) {
+            NSLog(@"ACTileManager: invalid coordinate input at index %@", @(i));
+            return NO;
+        }
+    }
+    
+    return YES;
+}
+
+/// Rasterize polygon into key buffer with zoom level
+/// @param coordinates Polygon vertices
+/// @param count Vertex count
+/// @param zoom Zoom level
+/// @param buffer Output key buffer
+- (void)rasterizePolygonCoordinates:(const CLLocationCoordinate2D *)coordinates count:(NSUInteger)count withZoom:(NSUInteger)zoom intoBuffer:(ACTileKeyBuffer *)buffer {
+    if (!coordinates || !count) return;
+    if (zoom > ACTileKeyMaximumZoom) {
+        NSLog(@"ACTileManager: zoom %@ exceeds maximum %@", @(zoom), @(ACTileKeyMaximumZoom));
+        return;
+    }
+    if (![self validateCoordinates:coordinates count:count]) return;
+    
+    // closing vertex is optional, drop it to keep each edge once
+    if (count > 1 && coordinates[0].latitude == coordinates[count - 1].latitude && coordinates[0].longitude == coordinates[count - 1].longitude) {
+        count--;
+    }
+    
+    CGPoint *points = malloc(count * sizeof(CGPoint));
+    for (NSUInteger i = 0; i < count; i++) {
+        points[i] = [_projector tilePointWithZoom:zoom atCoordinate:coordinates[i]];
+    }
+    
+    ACTileRasterizePolygon(points, count, zoom, buffer);
+    free(points);
+}
+
+/// Rasterize polyline with buffer distance into key buffer with zoom level,
+/// each segment is widened into a rectangle that contains its buffer capsule
+/// @param coordinates Polyline vertices
+/// @param count Vertex count
+/// @param distance Buffer distance in meters
+/// @param zoom Zoom level
+/// @param buffer Output key buffer
+- (void)rasterizePolylineCoordinates:(const CLLocationCoordinate2D *)coordinates count:(NSUInteger)count bufferDistance:(CLLocationDistance)distance withZoom:(NSUInteger)zoom intoBuffer:(ACTileKeyBuffer *)buffer {
+    if (!coordinates || !count) return;
+    if (zoom > ACTileKeyMaximumZoom) {
+        NSLog(@"ACTileManager: zoom %@ exceeds maximum %@", @(zoom), @(ACTileKeyMaximumZoom));
+        return;
+    }
+    if (![self validateCoordinates:coordinates count:count]) return;
+    
+    CLLocationDistance span = [_projector tileSpanInMetersWithZoom:zoom];
+    CGPoint previous = [_projector tilePointWithZoom:zoom atCoordinate:coordinates[0]];
+    for (NSUInteger i = 0; i < MAX(count, 2) - 1; i++) {
+        CLLocationCoordinate2D fromCoordinate = coordinates[i];
+        CLLocationCoordinate2D toCoordinate = coordinates[MIN(i + 1, count - 1)];
+        CGPoint from = previous;
+        CGPoint to = [_projector tilePointWithZoom:zoom atCoordinate:toCoordinate];
+        previous = to;
+        
+        if (distance <= 0) {
+            ACTileRasterizeSegment(from, to, zoom, buffer);
+            continue;
+        }
+        
+        // ground distance stretches by 1 / cos(latitude) in mercator
+        CLLocationDegrees latitude = (fromCoordinate.latitude + toCoordinate.latitude) / 2.0;
+        CGFloat radius = distance / MAX(cos(latitude * M_PI / 180.0), 1e-6) / span;
+        
+        CGFloat dx = to.x - from.x;
+        CGFloat dy = to.y - from.y;
+        CGFloat length = sqrt(dx * dx + dy * dy);
+        CGPoint direction = length > 0 ? CGPointMake(dx / length * radius, dy / length * radius) : CGPointMake(radius, 0);
+        CGPoint normal = CGPointMake(-direction.y, direction.x);
+        
+        CGPoint corners[4] = {
+            CGPointMake(from.x - direction.x + normal.x, from.y - direction.y + normal.y),
+            CGPointMake(to.x + direction.x + normal.x, to.y + direction.y + normal.y),
+            CGPointMake(to.x + direction.x - normal.x, to.y + direction.y - normal.y),
+            CGPointMake(from.x - direction.x - normal.x, from.y - direction.y - normal.y)
+        };
+        ACTileRasterizePolygon(corners, 4, zoom, buffer);
+    }
+}
+
 @end
@@ -81,17 +81,18 @@ ACTileBoundingBox ACTileBoundingBoxMake(CLLocationCoordinate2D northWest,
 ACTileBoundingBox ACTileBoundingBoxInvalid(void);
 
 
+/// Immutable tile region, instances are shared by ACTileManager across lookups
 @interface ACTileRegion : NSObject <NSCopying>
 
 
 /// Tile code for region under Google schema
-@property (nonatomic, copy) NSString    *tileCode;
+@property (nonatomic, copy, readonly) NSString    *tileCode;
 
 /// ACTileRegion tile info, contains x, y, zoom and size
-@property (nonatomic, assign)   ACTileData  data;
+@property (nonatomic, assign, readonly)   ACTileData  data;
 
 /// ACTileRegion bounding info, contains four corner's coordinate
-@property (nonatomic, assign)   ACTileBoundingBox   bounding;
+@property (nonatomic, assign, readonly)   ACTileBoundingBox   bounding;
 
 
 /// Designate initializer for ACTileRegion object
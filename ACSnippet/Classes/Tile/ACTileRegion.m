@@ -59,20 +59,6 @@ ACTileBoundingBox ACTileBoundingBoxInvalid(void) {
     return self;
 }
 
-/// Initializer used only for copy
-/// @param data Tile data
-/// @param bounding Tile bounding box
-/// @param code Tile code
-- (instancetype)initWithTileData:(ACTileData)data boundingBox:(ACTileBoundingBox)bounding code:(NSString *)code {
-    self = [super init];
-    if (self) {
-        _data = data;
-        _bounding = bounding;
-        _tileCode = code;
-    }
-    return self;
-}
-
 - (NSString *)description {
     return [NSString stringWithFormat:@"Tile: %@[%@]\nBounding:\n\tNW: (%6f, %6f)\n\tSW: (%6f, %6f)\n\tNE: (%6f, %6f)\n\tSE: (%6f, %6f)",
             _tileCode,
@@ -96,18 +82,18 @@ ACTileBoundingBox ACTileBoundingBoxInvalid(void) {
 }
 
 - (NSUInteger)hash {
-    NSUInteger pixelHash = [@(_data.pixelSize) hash];
-    NSUInteger zoomHash = [@(_data.zoom) hash];
-    NSUInteger xHash = [@(_data.x) hash];
-    NSUInteger yHash = [@(_data.y) hash];
-    return pixelHash ^ zoomHash ^ xHash ^ yHash;
+    // mix fields directly, boxing each field costs an allocation per call
+    NSUInteger hash = (NSUInteger)_data.pixelSize;
+    hash = hash * 31 + (NSUInteger)_data.zoom;
+    hash = hash * 31 + (NSUInteger)_data.x;
+    hash = hash * 31 + (NSUInteger)_data.y;
+    return hash;
 }
 
 #pragma mark - NSCopying
 - (id)copyWithZone:(nullable NSZone *)zone {
-    return [[ACTileRegion allocWithZone:zone] initWithTileData:_data
-                                                   boundingBox:_bounding
-                                                          code:_tileCode];
+    // immutable, share the same instance
+    return self;
 }
 
 @end
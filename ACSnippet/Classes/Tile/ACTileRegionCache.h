@@ -0,0 +1,61 @@
+//
+//  ACTileRegionCache.h
+//  ACSnippet
+//
+//  Created by Wenzhi WU on 19/10/2026.
+//  Copyright © 2026 Wenzhi WU. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import "ACTileRegion.h"
+#import "ACTileKey.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// Bounded, thread-safe flyweight cache that shares immutable ACTileRegion objects by tile identity,
+/// least recently referenced regions are replaced by CLOCK eviction when capacity is reached
+@interface ACTileRegionCache : NSObject
+
+/// Maximum number of cached regions
+@property (nonatomic, assign, readonly) NSUInteger capacity;
+
+/// Number of cached regions
+@property (nonatomic, assign, readonly) NSUInteger count;
+
+/// Number of lookups served from cache
+@property (nonatomic, assign, readonly) NSUInteger hitCount;
+
+/// Number of lookups not found in cache
+@property (nonatomic, assign, readonly) NSUInteger missCount;
+
+/// Number of regions allocated and stored into cache
+@property (nonatomic, assign, readonly) NSUInteger allocationCount;
+
+/// Number of regions evicted to keep capacity
+@property (nonatomic, assign, readonly) NSUInteger evictionCount;
+
+/// Ratio of hits to lookups, 0 if there is no lookup
+@property (nonatomic, assign, readonly) double hitRate;
+
+/// Designate initializer for ACTileRegionCache object
+/// @param capacity Maximum number of cached regions
+- (instancetype)initWithCapacity:(NSUInteger)capacity;
+
+/// Get cached region for tile key
+/// @param key Tile key
+- (nullable ACTileRegion *)regionForKey:(ACTileKey)key;
+
+/// Store region for tile key and return the shared instance, which is the region cached by another thread if it wins the race
+/// @param region Tile region
+/// @param key Tile key
+- (ACTileRegion *)storeRegion:(ACTileRegion *)region forKey:(ACTileKey)key;
+
+/// Remove all cached regions
+- (void)removeAllRegions;
+
+/// Reset hit, miss, allocation and eviction counters
+- (void)resetStatistics;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,262 @@
+//
+//  ACTileRegionCache.m
+//  ACSnippet
+//
+//  Created by Wenzhi WU on 19/10/2026.
+//  Copyright © 2026 Wenzhi WU. All rights reserved.
+//
+
+#import "ACTileRegionCache.h"
+#import <pthread.h>
+
+/// A structure that maps tile key to region slot in open addressing table
+///
+/// Fields:
+///    key:
+///        Tile key, ACTileKeyInvalid for empty bucket
+///    slot:
+///        Index of region slot
+struct ACTileRegionBucket {
+    ACTileKey   key;
+    NSUInteger  slot;
+};
+typedef struct ACTileRegionBucket ACTileRegionBucket;
+
+static inline NSUInteger ACTileKeyHash(ACTileKey key) {
+    uint64_t hash = key * 0x9E3779B97F4A7C15ULL;
+    return (NSUInteger)(hash ^ (hash >> 32));
+}
+
+
+@interface ACTileRegionCache () {
+    ACTileRegionBucket  *_buckets;
+    NSUInteger          _bucketMask;
+    ACTileKey           *_slotKeys;
+    uint8_t             *_referenced;
+    NSUInteger          _hand;
+
+    // counters have locked getters, so they are declared instead of synthesized
+    NSUInteger          _hitCount;
+    NSUInteger          _missCount;
+    NSUInteger          _allocationCount;
+    NSUInteger          _evictionCount;
+}
+
+/// Lock for thread safe
+@property (nonatomic, assign) pthread_mutex_t lock;
+
+/// Cached regions indexed by slot
+@property (nonatomic, strong) NSMutableArray <ACTileRegion *> *regions;
+
+@end
+
+@implementation ACTileRegionCache
+
+- (instancetype)init {
+    return [self initWithCapacity:1024];
+}
+
+- (instancetype)initWithCapacity:(NSUInteger)capacity {
+    self = [super init];
+    if (self) {
+        pthread_mutex_init(&_lock, NULL);
+        _capacity = MAX(1, capacity);
+
+        NSUInteger buckets = 2;
+        while (buckets < _capacity * 2) buckets <<= 1;
+        _bucketMask = buckets - 1;
+        _buckets = malloc(buckets * sizeof(ACTileRegionBucket));
+        for (NSUInteger i = 0; i < buckets; i++) {
+            _buckets[i].key = ACTileKeyInvalid;
+        }
+
+        _slotKeys = malloc(_capacity * sizeof(ACTileKey));
+        _referenced = calloc(_capacity, sizeof(uint8_t));
+        _regions = [NSMutableArray arrayWithCapacity:_capacity];
+    }
+
+    return self;
+}
+
+- (void)dealloc {
+    free(_buckets);
+    free(_slotKeys);
+    free(_referenced);
+    pthread_mutex_destroy(&_lock);
+}
+
+- (NSUInteger)count {
+    pthread_mutex_lock(&_lock);
+    NSUInteger count = _regions.count;
+    pthread_mutex_unlock(&_lock);
+    return count;
+}
+
+- (NSUInteger)hitCount {
+    pthread_mutex_lock(&_lock);
+    NSUInteger count = _hitCount;
+    pthread_mutex_unlock(&_lock);
+    return count;
+}
+
+- (NSUInteger)missCount {
+    pthread_mutex_lock(&_lock);
+    NSUInteger count = _missCount;
+    pthread_mutex_unlock(&_lock);
+    return count;
+}
+
+- (NSUInteger)allocationCount {
+    pthread_mutex_lock(&_lock);
+    NSUInteger count = _allocationCount;
+    pthread_mutex_unlock(&_lock);
+    return count;
+}
+
+- (NSUInteger)evictionCount {
+    pthread_mutex_lock(&_lock);
+    NSUInteger count = _evictionCount;
+    pthread_mutex_unlock(&_lock);
+    return count;
+}
+
+- (double)hitRate {
+    pthread_mutex_lock(&_lock);
+    NSUInteger lookups = _hitCount + _missCount;
+    double rate = lookups ? (double)_hitCount / lookups : 0;
+    pthread_mutex_unlock(&_lock);
+    return rate;
+}
+
+- (ACTileRegion *)regionForKey:(ACTileKey)key {
+    if (key == ACTileKeyInvalid) return nil;
+
+    ACTileRegion *region = nil;
+    pthread_mutex_lock(&_lock);
+    NSUInteger bucket = [self bucketForKey:key];
+    if (bucket != NSNotFound) {
+        NSUInteger slot = _buckets[bucket].slot;
+        _referenced[slot] = 1;
+        region = _regions[slot];
+        _hitCount++;
+    } else {
+        _missCount++;
+    }
+    pthread_mutex_unlock(&_lock);
+    return region;
+}
+
+- (ACTileRegion *)storeRegion:(ACTileRegion *)region forKey:(ACTileKey)key {
+    if (key == ACTileKeyInvalid || !region) return region;
+
+    ACTileRegion *evicted = nil;
+    pthread_mutex_lock(&_lock);
+    NSUInteger bucket = [self bucketForKey:key];
+    if (bucket != NSNotFound) {
+        region = _regions[_buckets[bucket].slot];
+    } else {
+        NSUInteger slot;
+        if (_regions.count < _capacity) {
+            slot = _regions.count;
+            [_regions addObject:region];
+        } else {
+            // second chance, clear referenced bits until an unreferenced slot shows up
+            while (_referenced[_hand]) {
+                _referenced[_hand] = 0;
+                _hand = (_hand + 1) % _capacity;
+            }
+
+            slot = _hand;
+            _hand = (_hand + 1) % _capacity;
+            [self removeBucketForKey:_slotKeys[slot]];
+            evicted = _regions[slot];
+            [_regions replaceObjectAtIndex:slot withObject:region];
+            _evictionCount++;
+        }
+
+        _slotKeys[slot] = key;
+        _referenced[slot] = 1;
+        [self insertBucketForKey:key slot:slot];
+        _allocationCount++;
+    }
+    pthread_mutex_unlock(&_lock);
+
+    // release evicted region out of lock
+    evicted = nil;
+    return region;
+}
+
+- (void)removeAllRegions {
+    pthread_mutex_lock(&_lock);
+    for (NSUInteger i = 0; i <= _bucketMask; i++) {
+        _buckets[i].key = ACTileKeyInvalid;
+    }
+
+    memset(_referenced, 0, _capacity * sizeof(uint8_t));
+    NSArray *holder = _regions.copy;
+    [_regions removeAllObjects];
+    _hand = 0;
+    pthread_mutex_unlock(&_lock);
+
+    holder = nil;
+}
+
+- (void)resetStatistics {
+    pthread_mutex_lock(&_lock);
+    _hitCount = 0;
+    _missCount = 0;
+    _allocationCount = 0;
+    _evictionCount = 0;
+    pthread_mutex_unlock(&_lock);
+}
+
+#pragma mark - Buckets
+/// Find bucket index for key by linear probing, lock should be held
+/// @param key Tile key
+- (NSUInteger)bucketForKey:(ACTileKey)key {
+    NSUInteger index = ACTileKeyHash(key) & _bucketMask;
+    while (_buckets[index].key != ACTileKeyInvalid) {
+        if (_buckets[index].key == key) return index;
+        index = (index + 1) & _bucketMask;
+    }
+
+    return NSNotFound;
+}
+
+/// Insert key into first empty bucket, lock should be held
+/// @param key Tile key
+/// @param slot Region slot index
+- (void)insertBucketForKey:(ACTileKey)key slot:(NSUInteger)slot {
+    NSUInteger index = ACTileKeyHash(key) & _bucketMask;
+    while (_buckets[index].key != ACTileKeyInvalid) {
+        index = (index + 1) & _bucketMask;
+    }
+
+    _buckets[index].key = key;
+    _buckets[index].slot = slot;
+}
+
+/// Remove key with backward shift so probing chains stay intact without tombstones, lock should be held
+/// @param key Tile key
+- (void)removeBucketForKey:(ACTileKey)key {
+    NSUInteger hole = [self bucketForKey:key];
+    if (hole == NSNotFound) return;
+
+    NSUInteger index = hole;
+    while (YES) {
+        index = (index + 1) & _bucketMask;
+        if (_buckets[index].key == ACTileKeyInvalid) break;
+
+        // keep entry in place if its home bucket lies cyclically within (hole, index]
+        NSUInteger home = ACTileKeyHash(_buckets[index].key) & _bucketMask;
+        BOOL inPlace = hole <= index ? (hole < home && home <= index) : (hole < home || home <= index);
+        if (inPlace) continue;
+
+        _buckets[hole] = _buckets[index];
+        hole = index;
+    }
+
+    _buckets[hole].key = ACTileKeyInvalid;
+}
+
+@end
@@ -0,0 +1,76 @@
+//
+//  ACTileViewportTracker.h
+//  ACSnippet
+//
+//  Created by Wenzhi WU on 19/10/2026.
+//  Copyright © 2026 Wenzhi WU. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import <CoreLocation/CoreLocation.h>
+#import "ACTileManager.h"
+#import "ACTileCollectionChanges.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+@class ACTileViewportTracker;
+
+/// Delegate protocol of ACTileViewportTracker object
+@protocol ACTileViewportTrackerDelegate <NSObject>
+
+/// Invoked on main queue with coalesced tile changes, entered tiles include look-ahead tiles in moving direction
+/// @param tracker ACTileViewportTracker object
+/// @param changes Tile changes since last invocation
+- (void)viewportTracker:(ACTileViewportTracker *)tracker didChangeTiles:(ACTileCollectionChanges *)changes;
+
+@end
+
+@interface ACTileViewportTracker : NSObject
+
+/// Delegate of ACTileViewportTracker object
+@property (nonatomic, weak) id <ACTileViewportTrackerDelegate> delegate;
+
+/// Viewport dimension in tiles
+@property (nonatomic, assign, readonly) NSUInteger dimension;
+
+/// Minimum interval between two change emissions, default 0.2 second
+@property (atomic, assign) NSTimeInterval emitInterval;
+
+/// Extra tiles around tracked region a tile must leave before it exits, default 1
+@property (atomic, assign) NSUInteger hysteresis;
+
+/// Seconds of current camera motion to look ahead, default 1 second
+@property (atomic, assign) NSTimeInterval lookAheadInterval;
+
+/// Maximum look-ahead offset in tiles, default is dimension
+@property (atomic, assign) NSUInteger maximumLookAhead;
+
+/// Tile codes currently tracked
+@property (nonatomic, copy, readonly) NSSet <NSString *> *trackedTileCodes;
+
+/// Designate initializer for ACTileViewportTracker object
+/// @param manager Tile manager for tile calculation
+/// @param dimension Odd number described viewport range
+- (instancetype)initWithTileManager:(ACTileManager *)manager dimension:(NSUInteger)dimension;
+
+/// Feed camera update, cheap enough to call at gesture frequency
+/// @param zoom Zoom level
+/// @param coordinate Camera center coordinate
+- (void)updateWithZoom:(NSUInteger)zoom centerCoordinate:(CLLocationCoordinate2D)coordinate;
+
+/// Feed camera update with explicit timestamp, used to replay recorded camera traces. Emissions are throttled
+/// on the trace clock only, changes pending after the last update of a trace are emitted by flush
+/// @param zoom Zoom level
+/// @param coordinate Camera center coordinate
+/// @param timestamp Trace time of update in seconds
+- (void)updateWithZoom:(NSUInteger)zoom centerCoordinate:(CLLocationCoordinate2D)coordinate timestamp:(NSTimeInterval)timestamp;
+
+/// Emit pending changes immediately without waiting for emit interval
+- (void)flush;
+
+/// Drop tracked tiles and motion state, tracked tiles are emitted as exited and next update enters all viewport tiles
+- (void)reset;
+
+@end
+
+NS_ASSUME_NONNULL_END
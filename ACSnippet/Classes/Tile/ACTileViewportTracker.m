@@ -0,0 +1,361 @@
+//
+//  ACTileViewportTracker.m
+//  ACSnippet
+//
+//  Created by Wenzhi WU on 19/10/2026.
+//  Copyright © 2026 Wenzhi WU. All rights reserved.
+//
+
+#import "ACTileViewportTracker.h"
+#import <QuartzCore/QuartzCore.h>
+
+/// Smoothing factor for camera velocity
+#define VELOCITY_SMOOTHING 0.5
+
+/// A structure that contains inclusive tile x/y bounds
+///
+/// Fields:
+///    minX:
+///        Minimum tile x
+///    minY:
+///        Minimum tile y
+///    maxX:
+///        Maximum tile x
+///    maxY:
+///        Maximum tile y
+struct ACTileRect {
+    NSInteger   minX;
+    NSInteger   minY;
+    NSInteger   maxX;
+    NSInteger   maxY;
+};
+typedef struct ACTileRect ACTileRect;
+
+/// Expand rect on every side and clamp it into world bounds at zoom level
+/// @param rect Tile rect
+/// @param inset Tiles to expand
+/// @param zoom Zoom level
+static ACTileRect ACTileRectExpand(ACTileRect rect, NSInteger inset, NSUInteger zoom) {
+    NSInteger max = (NSInteger)(1ULL << zoom) - 1;
+    rect.minX = MAX(0, rect.minX - inset);
+    rect.minY = MAX(0, rect.minY - inset);
+    rect.maxX = MIN(max, rect.maxX + inset);
+    rect.maxY = MIN(max, rect.maxY + inset);
+    return rect;
+}
+
+static BOOL ACTileRectContains(ACTileRect rect, NSInteger x, NSInteger y) {
+    return x >= rect.minX && x <= rect.maxX && y >= rect.minY && y <= rect.maxY;
+}
+
+/// Number of tiles in rect, zero for empty rect
+static NSUInteger ACTileRectArea(ACTileRect rect) {
+    if (rect.maxX < rect.minX || rect.maxY < rect.minY) return 0;
+    return (NSUInteger)((rect.maxX - rect.minX + 1) * (rect.maxY - rect.minY + 1));
+}
+
+static int ACTileKeyCompare(const void *lh, const void *rh) {
+    ACTileKey left = *(const ACTileKey *)lh;
+    ACTileKey right = *(const ACTileKey *)rh;
+    return left < right ? -1 : (left > right ? 1 : 0);
+}
+
+
+@interface ACTileViewportTracker ()
+
+/// Tile manager for tile calculation
+@property (nonatomic, strong)   ACTileManager   *manager;
+
+/// Serial queue guarding tracking state
+@property (nonatomic, strong)   dispatch_queue_t    queue;
+
+/// Tracked tile keys in ascending order
+@property (nonatomic, strong)   NSMutableData   *tracked;
+
+/// Number of tracked tile keys
+@property (nonatomic, assign)   NSUInteger  trackedCount;
+
+/// Zoom level of tracked tiles, -1 if nothing tracked
+@property (nonatomic, assign)   NSInteger   trackedZoom;
+
+/// Latest camera zoom level
+@property (nonatomic, assign)   NSUInteger  zoom;
+
+/// Latest camera center in fractional tile x/y
+@property (nonatomic, assign)   CGPoint center;
+
+/// Timestamp of latest camera update
+@property (nonatomic, assign)   NSTimeInterval  timestamp;
+
+/// Smoothed camera velocity in tiles per second
+@property (nonatomic, assign)   CGPoint velocity;
+
+/// Has camera update not emitted yet
+@property (nonatomic, assign)   BOOL    pending;
+
+/// Has emission been scheduled
+@property (nonatomic, assign)   BOOL    scheduled;
+
+/// Timestamp of last emission, on the clock of camera updates
+@property (nonatomic, assign)   NSTimeInterval  lastEmitTime;
+
+@end
+
+@implementation ACTileViewportTracker
+
+- (instancetype)initWithTileManager:(ACTileManager *)manager dimension:(NSUInteger)dimension {
+    self = [super init];
+    if (self) {
+        _manager = manager;
+        _dimension = MAX(1, dimension);
+        _emitInterval = 0.2;
+        _hysteresis = 1;
+        _lookAheadInterval = 1.0;
+        _maximumLookAhead = _dimension;
+        _queue = dispatch_queue_create("com.mrcrow.aicity.tile.viewport", DISPATCH_QUEUE_SERIAL);
+        _tracked = [NSMutableData data];
+        _trackedZoom = -1;
+        _timestamp = -1;
+        _lastEmitTime = -DBL_MAX;
+    }
+
+    return self;
+}
+
+- (NSSet <NSString *>*)trackedTileCodes {
+    __block NSSet *codes = nil;
+    dispatch_sync(_queue, ^{
+        codes = [NSSet setWithArray:[self tileCodesWithKeys:self.tracked.bytes count:self.trackedCount]];
+    });
+
+    return codes;
+}
+
+- (void)updateWithZoom:(NSUInteger)zoom centerCoordinate:(CLLocationCoordinate2D)coordinate {
+    [self updateWithZoom:zoom centerCoordinate:coordinate timestamp:CACurrentMediaTime() replay:NO];
+}
+
+- (void)updateWithZoom:(NSUInteger)zoom centerCoordinate:(CLLocationCoordinate2D)coordinate timestamp:(NSTimeInterval)timestamp {
+    [self updateWithZoom:zoom centerCoordinate:coordinate timestamp:timestamp replay:YES];
+}
+
+/// Feed camera update
+/// @param zoom Zoom level
+/// @param coordinate Camera center coordinate
+/// @param timestamp Time of update in seconds
+/// @param replay Whether timestamp comes from a recorded trace rather than media time
+- (void)updateWithZoom:(NSUInteger)zoom centerCoordinate:(CLLocationCoordinate2D)coordinate timestamp:(NSTimeInterval)timestamp replay:(BOOL)replay {
+    if (!CLLocationCoordinate2DIsValid(coordinate)) {
+        NSLog(@"ACTileViewportTracker: invalid coordinate input");
+        return;
+    }
+    if (zoom > ACTileKeyMaximumZoom) {
+        NSLog(@"ACTileViewportTracker: zoom %@ exceeds maximum %@", @(zoom), @(ACTileKeyMaximumZoom));
+        return;
+    }
+
+    CGPoint center = [_manager tilePointWithZoom:zoom atCoordinate:coordinate];
+    dispatch_async(_queue, ^{
+        [self trackCenter:center zoom:zoom timestamp:timestamp];
+        [self scheduleEmissionAtTime:timestamp replay:replay];
+    });
+}
+
+- (void)flush {
+    dispatch_async(_queue, ^{
+        [self emitAtTime:self.timestamp];
+    });
+}
+
+- (void)reset {
+    dispatch_async(_queue, ^{
+        NSArray *exited = [self tileCodesWithKeys:self.tracked.bytes count:self.trackedCount];
+        self.tracked.length = 0;
+        self.trackedCount = 0;
+        self.trackedZoom = -1;
+        self.timestamp = -1;
+        self.velocity = CGPointZero;
+        self.pending = NO;
+        self.lastEmitTime = -DBL_MAX;
+
+        if ([exited count]) {
+            [self notifyChanges:[[ACTileCollectionChanges alloc] initWithEntered:@[] exited:exited remained:@[]]];
+        }
+    });
+}
+
+/// Update camera state and velocity, zoom changes restart velocity tracking
+/// @param center Camera center in fractional tile x/y
+/// @param zoom Zoom level
+/// @param timestamp Media time of update
+- (void)trackCenter:(CGPoint)center zoom:(NSUInteger)zoom timestamp:(NSTimeInterval)timestamp {
+    NSTimeInterval elapsed = timestamp - _timestamp;
+    if (_timestamp < 0 || zoom != _zoom) {
+        _velocity = CGPointZero;
+    } else if (elapsed > 0) {
+        CGPoint instant = CGPointMake((center.x - _center.x) / elapsed, (center.y - _center.y) / elapsed);
+        _velocity = CGPointMake(_velocity.x + (instant.x - _velocity.x) * VELOCITY_SMOOTHING,
+                                _velocity.y + (instant.y - _velocity.y) * VELOCITY_SMOOTHING);
+    }
+
+    _zoom = zoom;
+    _center = center;
+    _timestamp = timestamp;
+    _pending = YES;
+}
+
+/// Emit now if emit interval has passed, otherwise emit for the rest of interval. Live updates schedule one
+/// emission on media time, replayed updates wait for a later update or flush, so both stay on their own clock
+/// @param now Time of latest update
+/// @param replay Whether time comes from a recorded trace
+- (void)scheduleEmissionAtTime:(NSTimeInterval)now replay:(BOOL)replay {
+    NSTimeInterval delay = _lastEmitTime + self.emitInterval - now;
+    if (delay <= 0) {
+        [self emitAtTime:now];
+        return;
+    }
+
+    if (replay || _scheduled) return;
+
+    _scheduled = YES;
+    __weak typeof(self) _self = self;
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(delay * NSEC_PER_SEC)), _queue, ^{
+        __strong typeof(_self) self = _self;
+        if (!self) return;
+        self.scheduled = NO;
+        [self emitAtTime:CACurrentMediaTime()];
+    });
+}
+/// Viewport rect around camera center
+- (ACTileRect)viewportRect {
+    NSInteger length = (NSInteger)(_dimension - 1) / 2;
+    ACTileRect rect;
+    rect.minX = (NSInteger)floor(_center.x) - length;
+    rect.minY = (NSInteger)floor(_center.y) - length;
+    rect.maxX = rect.minX + (NSInteger)_dimension - 1;
+    rect.maxY = rect.minY + (NSInteger)_dimension - 1;
+    return ACTileRectExpand(rect, 0, _zoom);
+}
+
+/// Viewport rect shifted by velocity over look-ahead interval
+- (ACTileRect)lookAheadRect {
+    CGFloat dx = _velocity.x * self.lookAheadInterval;
+    CGFloat dy = _velocity.y * self.lookAheadInterval;
+    CGFloat distance = sqrt(dx * dx + dy * dy);
+    CGFloat limit = self.maximumLookAhead;
+    if (distance > limit) {
+        dx = dx / distance * limit;
+        dy = dy / distance * limit;
+    }
+
+    NSInteger length = (NSInteger)(_dimension - 1) / 2;
+    ACTileRect rect;
+    rect.minX = (NSInteger)floor(_center.x + dx) - length;
+    rect.minY = (NSInteger)floor(_center.y + dy) - length;
+    rect.maxX = rect.minX + (NSInteger)_dimension - 1;
+    rect.maxY = rect.minY + (NSInteger)_dimension - 1;
+    return ACTileRectExpand(rect, 0, _zoom);
+}
+
+/// Diff tracked tiles against viewport and look-ahead region and notify delegate
+/// @param now Time of emission on the clock of camera updates
+- (void)emitAtTime:(NSTimeInterval)now {
+    if (!_pending) return;
+    _pending = NO;
+    _lastEmitTime = now;
+
+    NSUInteger zoom = _zoom;
+    ACTileRect viewport = [self viewportRect];
+    ACTileRect lookAhead = [self lookAheadRect];
+
+    // desired keys, viewport first then look-ahead tiles outside it, sorted once for merging
+    NSUInteger capacity = ACTileRectArea(viewport) + ACTileRectArea(lookAhead);
+    ACTileKey *desired = malloc(MAX(capacity, 1) * sizeof(ACTileKey));
+    NSUInteger desiredCount = 0;
+    for (NSInteger x = viewport.minX; x <= viewport.maxX; x++) {
+        for (NSInteger y = viewport.minY; y <= viewport.maxY; y++) {
+            desired[desiredCount++] = ACTileKeyMake(zoom, x, y);
+        }
+    }
+
+    for (NSInteger x = lookAhead.minX; x <= lookAhead.maxX; x++) {
+        for (NSInteger y = lookAhead.minY; y <= lookAhead.maxY; y++) {
+            if (ACTileRectContains(viewport, x, y)) continue;
+            desired[desiredCount++] = ACTileKeyMake(zoom, x, y);
+        }
+    }
+    qsort(desired, desiredCount, sizeof(ACTileKey), ACTileKeyCompare);
+
+    // tracked keys stay while inside expanded regions, sorted order is kept by compacting in place
+    ACTileKey *tracked = _tracked.mutableBytes;
+    NSUInteger keptCount = 0;
+    NSMutableArray *exited = @[].mutableCopy;
+    NSMutableArray *remained = @[].mutableCopy;
+    if (_trackedZoom != (NSInteger)zoom) {
+        [exited addObjectsFromArray:[self tileCodesWithKeys:tracked count:_trackedCount]];
+    } else {
+        NSInteger inset = self.hysteresis;
+        ACTileRect keptViewport = ACTileRectExpand(viewport, inset, zoom);
+        ACTileRect keptLookAhead = ACTileRectExpand(lookAhead, inset, zoom);
+        for (NSUInteger i = 0; i < _trackedCount; i++) {
+            ACTileKey key = tracked[i];
+            NSInteger x = ACTileKeyX(key);
+            NSInteger y = ACTileKeyY(key);
+            if (ACTileRectContains(keptViewport, x, y) || ACTileRectContains(keptLookAhead, x, y)) {
+                tracked[keptCount++] = key;
+                [remained addObject:[_manager tileCodeWithTileKey:key]];
+            } else {
+                [exited addObject:[_manager tileCodeWithTileKey:key]];
+            }
+        }
+    }
+
+    // merge kept and desired keys, desired keys missing from kept ones enter
+    NSMutableData *merged = [NSMutableData dataWithLength:(keptCount + desiredCount) * sizeof(ACTileKey)];
+    ACTileKey *output = merged.mutableBytes;
+    NSUInteger count = 0, i = 0, j = 0;
+    NSMutableArray *entered = @[].mutableCopy;
+    while (i < keptCount || j < desiredCount) {
+        if (j == desiredCount || (i < keptCount && tracked[i] < desired[j])) {
+            output[count++] = tracked[i++];
+        } else if (i == keptCount || desired[j] < tracked[i]) {
+            [entered addObject:[_manager tileCodeWithTileKey:desired[j]]];
+            output[count++] = desired[j++];
+        } else {
+            output[count++] = tracked[i++];
+            j++;
+        }
+    }
+    free(desired);
+
+    merged.length = count * sizeof(ACTileKey);
+    _tracked = merged;
+    _trackedCount = count;
+    _trackedZoom = zoom;
+
+    if (![entered count] && ![exited count]) return;
+
+    [self notifyChanges:[[ACTileCollectionChanges alloc] initWithEntered:entered.copy
+                                                                  exited:exited.copy
+                                                                remained:remained.copy]];
+}
+
+/// Tile codes of keys, codes are only built for delegate output
+- (NSArray <NSString *>*)tileCodesWithKeys:(const ACTileKey *)keys count:(NSUInteger)count {
+    NSMutableArray *codes = [NSMutableArray arrayWithCapacity:count];
+    for (NSUInteger i = 0; i < count; i++) {
+        [codes addObject:[_manager tileCodeWithTileKey:keys[i]]];
+    }
+
+    return codes.copy;
+}
+
+- (void)notifyChanges:(ACTileCollectionChanges *)changes {
+    dispatch_async(dispatch_get_main_queue(), ^{
+        if (self.delegate && [self.delegate respondsToSelector:@selector(viewportTracker:didChangeTiles:)]) {
+            [self.delegate viewportTracker:self didChangeTiles:changes];
+        }
+    });
+}
+
+@end
@@ -0,0 +1,110 @@
+//
+//  ACBeaconAggregatorTests.m
+//  ACSnippet_Tests
+//
+//  Created by Wenzhi WU on 19/10/2026.
+//  Copyright © 2026 Wenzhi WU. All rights reserved.
+//
+
+@import XCTest;
+#import <ACSnippet/ACBeaconAggregator.h>
+
+@interface ACBeaconAggregatorTests : XCTestCase
+@property (nonatomic, strong) NSUUID *uuid;
+@end
+
+@implementation ACBeaconAggregatorTests
+
+- (void)setUp {
+    [super setUp];
+    _uuid = [[NSUUID alloc] initWithUUIDString:@"FDA50693-A4E2-4FB1-AFCF-C6EB07647825"];
+}
+
+- (void)testReplayConvergesAndKeepsLatestSamples {
+    ACBeaconAggregator *aggregator = [[ACBeaconAggregator alloc] initWithCapacity:8];
+    ACBeaconIdentity identity = ACBeaconIdentityMake(_uuid, 10001, 7);
+    ACBeaconSample samples[40];
+    for (NSUInteger i = 0; i < 40; i++) {
+        // noisy readings around -70 dB and 3 m
+        double noise = (i % 2 ? 1.0 : -1.0);
+        samples[i] = ACBeaconSampleMake(identity, -70 + (NSInteger)(noise * 4), 3.0 + noise, i * 0.5);
+    }
+    [aggregator ingestSamples:samples count:40];
+
+    ACBeaconEstimate estimate;
+    XCTAssertTrue([aggregator getEstimate:&estimate forIdentity:ACBeaconIdentityMake(_uuid, 10001, 7)]);
+    XCTAssertEqual(estimate.sampleCount, 40);
+    XCTAssertEqualWithAccuracy(estimate.rssi, -70, 3);
+    XCTAssertEqualWithAccuracy(estimate.accuracy, 3.0, 0.5);
+    XCTAssertEqualWithAccuracy(estimate.lastSeen, 19.5, 0.001);
+
+    ACBeaconSample buffered[ACBeaconSampleWindow];
+    NSUInteger count = [aggregator getSamples:buffered maxCount:ACBeaconSampleWindow forIdentity:identity];
+    XCTAssertEqual(count, ACBeaconSampleWindow);
+    XCTAssertEqualWithAccuracy(buffered[0].timestamp, (40 - ACBeaconSampleWindow) * 0.5, 0.001);
+    XCTAssertEqualWithAccuracy(buffered[count - 1].timestamp, 19.5, 0.001);
+}
+
+- (void)testUnknownReadingsDoNotMoveEstimate {
+    ACBeaconAggregator *aggregator = [ACBeaconAggregator new];
+    ACBeaconIdentity identity = ACBeaconIdentityMake(_uuid, 1, 1);
+    ACBeaconSample samples[] = {
+        ACBeaconSampleMake(identity, -60, 2.0, 0),
+        ACBeaconSampleMake(identity, 0, -1, 1),
+    };
+    [aggregator ingestSamples:samples count:2];
+
+    ACBeaconEstimate estimate;
+    XCTAssertTrue([aggregator getEstimate:&estimate forIdentity:identity]);
+    XCTAssertEqualWithAccuracy(estimate.rssi, -60, 0.001);
+    XCTAssertEqualWithAccuracy(estimate.accuracy, 2.0, 0.001);
+}
+
+- (void)testUnknownReadingsDoNotShortenMeasurementGap {
+    ACBeaconIdentity identity = ACBeaconIdentityMake(_uuid, 1, 1);
+    ACBeaconAggregator *gapped = [ACBeaconAggregator new];
+    ACBeaconAggregator *interleaved = [ACBeaconAggregator new];
+    ACBeaconSample known[] = {
+        ACBeaconSampleMake(identity, -60, 2.0, 0),
+        ACBeaconSampleMake(identity, -60, 6.0, 8),
+    };
+    [gapped ingestSamples:known count:2];
+
+    // known readings 8 s apart stay within stale interval, so neither beacon is swept
+    ACBeaconSample samples[9];
+    samples[0] = known[0];
+    for (NSUInteger i = 1; i < 8; i++) {
+        samples[i] = ACBeaconSampleMake(identity, 0, -1, i);
+    }
+    samples[8] = known[1];
+    [interleaved ingestSamples:samples count:9];
+
+    ACBeaconEstimate expected, estimate;
+    XCTAssertTrue([gapped getEstimate:&expected forIdentity:identity]);
+    XCTAssertTrue([interleaved getEstimate:&estimate forIdentity:identity]);
+    XCTAssertEqualWithAccuracy(estimate.accuracy, expected.accuracy, 0.0001);
+    XCTAssertEqualWithAccuracy(estimate.accuracyVariance, expected.accuracyVariance, 0.0001);
+}
+
+- (void)testStaleAndOverflowEviction {
+    ACBeaconAggregator *aggregator = [[ACBeaconAggregator alloc] initWithCapacity:4];
+    aggregator.staleInterval = 5;
+    ACBeaconSample samples[6];
+    for (uint16_t minor = 0; minor < 6; minor++) {
+        samples[minor] = ACBeaconSampleMake(ACBeaconIdentityMake(_uuid, 1, minor), -65, 1.0, minor * 0.1);
+    }
+    [aggregator ingestSamples:samples count:6];
+
+    // the two least recently seen beacons made room for the last two
+    XCTAssertEqual(aggregator.count, 4);
+    XCTAssertFalse([aggregator getEstimate:NULL forIdentity:ACBeaconIdentityMake(_uuid, 1, 0)]);
+    XCTAssertTrue([aggregator getEstimate:NULL forIdentity:ACBeaconIdentityMake(_uuid, 1, 5)]);
+
+    ACBeaconSample fresh = ACBeaconSampleMake(ACBeaconIdentityMake(_uuid, 1, 5), -65, 1.0, 4.0);
+    [aggregator ingestSamples:&fresh count:1];
+    XCTAssertEqual([aggregator evictStaleBeaconsAtTimestamp:4.0], 0);
+    XCTAssertEqual([aggregator evictStaleBeaconsAtTimestamp:8.0], 3);
+    XCTAssertEqual(aggregator.count, 1);
+}
+
+@end
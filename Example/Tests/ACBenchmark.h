@@ -0,0 +1,106 @@
+//
+//  ACBenchmark.h
+//  ACSnippet_Tests
+//
+//  Created by Wenzhi WU on 19/10/2026.
+//  Copyright © 2026 Wenzhi WU. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// Result of one benchmark workload
+@interface ACBenchmarkResult : NSObject
+
+/// Workload name
+@property (nonatomic, copy, readonly) NSString  *name;
+
+/// Number of measured operations
+@property (nonatomic, assign, readonly) NSUInteger  operations;
+
+/// Mean cost of one operation in nanoseconds
+@property (nonatomic, assign, readonly) double  nanosecondsPerOperation;
+
+/// Net malloc blocks per operation still in use when a batch ends, before its autorelease pool drains, so
+/// blocks freed within the batch are not counted. NAN where malloc zone statistics are not available
+@property (nonatomic, assign, readonly) double  allocationsPerOperation;
+
+/// Whether percentiles are taken over batch means, reported as batch_p50 and so on, instead of single operations
+@property (nonatomic, assign, readonly) BOOL    batchPercentiles;
+
+/// Latency percentiles in nanoseconds, of one operation or of the batch mean when batchPercentiles
+@property (nonatomic, assign, readonly) double  p50;
+@property (nonatomic, assign, readonly) double  p90;
+@property (nonatomic, assign, readonly) double  p99;
+@property (nonatomic, assign, readonly) double  max;
+
+/// Extra workload counters, e.g. hit rate
+@property (nonatomic, copy, readonly) NSDictionary <NSString *, NSNumber *> *counters;
+
+/// Dictionary representation for machine-readable output
+- (NSDictionary *)dictionaryRepresentation;
+
+@end
+
+/// Monotonic clock in nanoseconds, portable to any POSIX Foundation
+FOUNDATION_EXPORT uint64_t ACBenchmarkTimestamp(void);
+
+/// Benchmark runner that times batches of operations and collects results for output
+@interface ACBenchmark : NSObject
+
+/// Collected results in run order
+@property (nonatomic, copy, readonly) NSArray <ACBenchmarkResult *> *results;
+
+/// Shared runner, results of all test cases go to one report
++ (instancetype)sharedBenchmark;
+
+/// Run workload and record result, latency percentiles are taken over batches and divided by batch size.
+/// Leading operations, at most one batch and a tenth of the workload, run untimed to warm up, each index
+/// still runs exactly once so the workload state is never touched twice
+/// @param name Workload name
+/// @param operations Number of operations, warm-up included
+/// @param batch Operations per timed batch
+/// @param block Operation block, index runs from 0 to operations - 1
+- (ACBenchmarkResult *)measure:(NSString *)name operations:(NSUInteger)operations batch:(NSUInteger)batch block:(void (NS_NOESCAPE ^)(NSUInteger index))block;
+
+/// Record workload timed by caller, e.g. asynchronous requests, latency percentiles are taken over single operations
+/// @param name Workload name
+/// @param elapsed Wall time of whole workload in nanoseconds
+/// @param latencies Latency of each completed operation in nanoseconds, sorted in place
+/// @param count Number of completed operations
+- (ACBenchmarkResult *)recordResultNamed:(NSString *)name elapsed:(double)elapsed latencies:(nullable double *)latencies count:(NSUInteger)count;
+
+/// Attach counters to result of the last workload with name
+/// @param counters Counter values
+/// @param name Workload name
+- (void)addCounters:(NSDictionary <NSString *, NSNumber *> *)counters toResultNamed:(NSString *)name;
+
+/// Write results as JSON, path is taken from ACSNIPPET_BENCHMARK_OUTPUT environment variable or temporary directory
+- (nullable NSString *)writeReport;
+
+@end
+
+/// Key stream generators for cache workloads
+@interface ACBenchmarkKeys : NSObject
+
+/// Uniformly distributed key indexes
+/// @param count Stream length
+/// @param universe Number of distinct keys
+/// @param seed Random seed
++ (NSData *)uniformIndexesWithCount:(NSUInteger)count universe:(NSUInteger)universe seed:(uint32_t)seed;
+
+/// Zipfian distributed key indexes, index 0 is the most popular
+/// @param count Stream length
+/// @param universe Number of distinct keys
+/// @param exponent Zipf exponent, 1.0 models typical tile popularity
+/// @param seed Random seed
++ (NSData *)zipfianIndexesWithCount:(NSUInteger)count universe:(NSUInteger)universe exponent:(double)exponent seed:(uint32_t)seed;
+
+/// Keys for indexes
+/// @param universe Number of distinct keys
++ (NSArray <NSString *>*)keysWithUniverse:(NSUInteger)universe;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,305 @@
+//
+//  ACBenchmark.m
+//  ACSnippet_Tests
+//
+//  Created by Wenzhi WU on 19/10/2026.
+//  Copyright © 2026 Wenzhi WU. All rights reserved.
+//
+
+#import "ACBenchmark.h"
+#import <time.h>
+#if defined(__APPLE__)
+#import <malloc/malloc.h>
+#endif
+
+/// Environment variable for report path
+static NSString *const ACBenchmarkOutputEnvironmentKey = @"ACSNIPPET_BENCHMARK_OUTPUT";
+
+uint64_t ACBenchmarkTimestamp(void) {
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return (uint64_t)time.tv_sec * 1000000000ULL + (uint64_t)time.tv_nsec;
+}
+
+/// Malloc blocks in use over all zones, 0 where malloc zone statistics are not available
+static int64_t ACBenchmarkBlocksInUse(void) {
+#if defined(__APPLE__)
+    malloc_statistics_t statistics;
+    malloc_zone_statistics(NULL, &statistics);
+    return (int64_t)statistics.blocks_in_use;
+#else
+    return 0;
+#endif
+}
+
+static int ACBenchmarkCompareDouble(const void *lh, const void *rh) {
+    double left = *(const double *)lh;
+    double right = *(const double *)rh;
+    return left < right ? -1 : (left > right ? 1 : 0);
+}
+
+#pragma mark - ACBenchmarkResult
+
+@interface ACBenchmarkResult ()
+@property (nonatomic, copy) NSString    *name;
+@property (nonatomic, assign) NSUInteger    operations;
+@property (nonatomic, assign) double    nanosecondsPerOperation;
+@property (nonatomic, assign) double    allocationsPerOperation;
+@property (nonatomic, assign) BOOL    batchPercentiles;
+@property (nonatomic, assign) double    p50;
+@property (nonatomic, assign) double    p90;
+@property (nonatomic, assign) double    p99;
+@property (nonatomic, assign) double    max;
+@property (nonatomic, copy) NSDictionary <NSString *, NSNumber *> *counters;
+@end
+
+@implementation ACBenchmarkResult
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _allocationsPerOperation = NAN;
+    }
+
+    return self;
+}
+
+- (NSDictionary *)dictionaryRepresentation {
+    NSString *prefix = _batchPercentiles ? @"batch_" : @"";
+    NSMutableDictionary *dictionary = @{@"name": _name,
+                                        @"operations": @(_operations),
+                                        @"ns_per_op": @(_nanosecondsPerOperation),
+                                        [prefix stringByAppendingString:@"p50_ns"]: @(_p50),
+                                        [prefix stringByAppendingString:@"p90_ns"]: @(_p90),
+                                        [prefix stringByAppendingString:@"p99_ns"]: @(_p99),
+                                        [prefix stringByAppendingString:@"max_ns"]: @(_max),
+                                        @"counters": _counters ?: @{}}.mutableCopy;
+    // JSON has no NAN
+    if (!isnan(_allocationsPerOperation)) dictionary[@"allocs_per_op"] = @(_allocationsPerOperation);
+    return dictionary.copy;
+}
+
+- (NSString *)description {
+    NSString *prefix = _batchPercentiles ? @"batch_" : @"";
+    return [NSString stringWithFormat:@"%-40@ %10.1f ns/op %8.2f allocs/op  %@p50 %.1f  %@p90 %.1f  %@p99 %.1f  %@max %.1f %@",
+            _name, _nanosecondsPerOperation, _allocationsPerOperation, prefix, _p50, prefix, _p90, prefix, _p99, prefix, _max,
+            [_counters count] ? _counters : @""];
+}
+
+@end
+
+#pragma mark - ACBenchmark
+
+@interface ACBenchmark ()
+@property (nonatomic, strong) NSMutableArray <ACBenchmarkResult *> *mutableResults;
+@end
+
+@implementation ACBenchmark
+
++ (instancetype)sharedBenchmark {
+    static ACBenchmark *_benchmark;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        _benchmark = [ACBenchmark new];
+    });
+
+    return _benchmark;
+}
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _mutableResults = @[].mutableCopy;
+    }
+
+    return self;
+}
+
+- (NSArray <ACBenchmarkResult *>*)results {
+    @synchronized (self) {
+        return _mutableResults.copy;
+    }
+}
+
+- (ACBenchmarkResult *)measure:(NSString *)name operations:(NSUInteger)operations batch:(NSUInteger)batch block:(void (NS_NOESCAPE ^)(NSUInteger))block {
+    operations = MAX(1, operations);
+    batch = MIN(MAX(1, batch), operations);
+
+    // warm up caches and lazy initialization with the leading operations, untimed
+    NSUInteger index = 0;
+    NSUInteger warmUp = MIN(batch, operations / 10);
+    for (; index < warmUp; index++) {
+        @autoreleasepool {
+            block(index);
+        }
+    }
+
+    NSUInteger measured = operations - warmUp;
+    NSUInteger batches = (measured + batch - 1) / batch;
+    double *samples = malloc(batches * sizeof(double));
+    uint64_t total = 0;
+    int64_t blocks = 0;
+    for (NSUInteger b = 0; b < batches; b++) {
+        NSUInteger end = MIN(index + batch, operations);
+        NSUInteger count = end - index;
+        @autoreleasepool {
+            // zone statistics are read outside the timed interval
+            int64_t blocksBefore = ACBenchmarkBlocksInUse();
+            uint64_t start = ACBenchmarkTimestamp();
+            for (; index < end; index++) {
+                block(index);
+            }
+            uint64_t elapsed = ACBenchmarkTimestamp() - start;
+            blocks += ACBenchmarkBlocksInUse() - blocksBefore;
+            total += elapsed;
+            samples[b] = (double)elapsed / count;
+        }
+    }
+
+    qsort(samples, batches, sizeof(double), ACBenchmarkCompareDouble);
+    ACBenchmarkResult *result = [ACBenchmarkResult new];
+    result.name = name;
+    result.operations = measured;
+    result.nanosecondsPerOperation = (double)total / measured;
+#if defined(__APPLE__)
+    result.allocationsPerOperation = (double)blocks / measured;
+#endif
+    result.batchPercentiles = batch > 1;
+    result.p50 = samples[(NSUInteger)(0.50 * (batches - 1))];
+    result.p90 = samples[(NSUInteger)(0.90 * (batches - 1))];
+    result.p99 = samples[(NSUInteger)(0.99 * (batches - 1))];
+    result.max = samples[batches - 1];
+    free(samples);
+
+    @synchronized (self) {
+        [_mutableResults addObject:result];
+    }
+    NSLog(@"ACBenchmark: %@", result);
+    return result;
+}
+
+- (ACBenchmarkResult *)recordResultNamed:(NSString *)name elapsed:(double)elapsed latencies:(double *)latencies count:(NSUInteger)count {
+    ACBenchmarkResult *result = [ACBenchmarkResult new];
+    result.name = name;
+    result.operations = count;
+    if (count) {
+        qsort(latencies, count, sizeof(double), ACBenchmarkCompareDouble);
+        result.nanosecondsPerOperation = elapsed / count;
+        result.p50 = latencies[(NSUInteger)(0.50 * (count - 1))];
+        result.p90 = latencies[(NSUInteger)(0.90 * (count - 1))];
+        result.p99 = latencies[(NSUInteger)(0.99 * (count - 1))];
+        result.max = latencies[count - 1];
+    }
+
+    @synchronized (self) {
+        [_mutableResults addObject:result];
+    }
+    NSLog(@"ACBenchmark: %@", result);
+    return result;
+}
+
+- (void)addCounters:(NSDictionary <NSString *, NSNumber *>*)counters toResultNamed:(NSString *)name {
+    @synchronized (self) {
+        for (ACBenchmarkResult *result in _mutableResults.reverseObjectEnumerator) {
+            if (![result.name isEqualToString:name]) continue;
+
+            NSMutableDictionary *merged = (result.counters ?: @{}).mutableCopy;
+            [merged addEntriesFromDictionary:counters];
+            result.counters = merged.copy;
+            break;
+        }
+    }
+}
+
+- (NSString *)writeReport {
+    NSString *path = [[NSProcessInfo processInfo] environment][ACBenchmarkOutputEnvironmentKey];
+    if (![path length]) {
+        path = [NSTemporaryDirectory() stringByAppendingPathComponent:@"acsnippet-benchmarks.json"];
+    }
+
+    NSMutableArray *results = @[].mutableCopy;
+    for (ACBenchmarkResult *result in self.results) {
+        [results addObject:[result dictionaryRepresentation]];
+    }
+
+    NSDictionary *report = @{@"suite": @"ACSnippet",
+                             @"timestamp": @([[NSDate date] timeIntervalSince1970]),
+                             @"os": [[NSProcessInfo processInfo] operatingSystemVersionString],
+                             @"results": results};
+    NSError *error = nil;
+    NSData *data = [NSJSONSerialization dataWithJSONObject:report options:NSJSONWritingPrettyPrinted error:&error];
+    if (!data || ![data writeToFile:path options:NSDataWritingAtomic error:&error]) {
+        NSLog(@"ACBenchmark: failed to write report %@", error);
+        return nil;
+    }
+
+    NSLog(@"ACBenchmark: report written to %@", path);
+    return path;
+}
+
+@end
+
+#pragma mark - ACBenchmarkKeys
+
+/// Deterministic xorshift generator, returns value in [0, 1)
+static inline double ACBenchmarkRandom(uint32_t *state) {
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return (double)x / 4294967296.0;
+}
+
+@implementation ACBenchmarkKeys
+
++ (NSData *)uniformIndexesWithCount:(NSUInteger)count universe:(NSUInteger)universe seed:(uint32_t)seed {
+    NSMutableData *data = [NSMutableData dataWithLength:count * sizeof(uint32_t)];
+    uint32_t *indexes = data.mutableBytes;
+    uint32_t state = seed ?: 1;
+    for (NSUInteger i = 0; i < count; i++) {
+        indexes[i] = (uint32_t)(ACBenchmarkRandom(&state) * universe);
+    }
+
+    return data.copy;
+}
+
++ (NSData *)zipfianIndexesWithCount:(NSUInteger)count universe:(NSUInteger)universe exponent:(double)exponent seed:(uint32_t)seed {
+    double *cdf = malloc(universe * sizeof(double));
+    double sum = 0;
+    for (NSUInteger i = 0; i < universe; i++) {
+        sum += 1.0 / pow(i + 1, exponent);
+        cdf[i] = sum;
+    }
+
+    NSMutableData *data = [NSMutableData dataWithLength:count * sizeof(uint32_t)];
+    uint32_t *indexes = data.mutableBytes;
+    uint32_t state = seed ?: 1;
+    for (NSUInteger i = 0; i < count; i++) {
+        double target = ACBenchmarkRandom(&state) * sum;
+        NSUInteger low = 0, high = universe - 1;
+        while (low < high) {
+            NSUInteger middle = (low + high) / 2;
+            if (cdf[middle] < target) {
+                low = middle + 1;
+            } else {
+                high = middle;
+            }
+        }
+        indexes[i] = (uint32_t)low;
+    }
+
+    free(cdf);
+    return data.copy;
+}
+
++ (NSArray <NSString *>*)keysWithUniverse:(NSUInteger)universe {
+    NSMutableArray *keys = [NSMutableArray arrayWithCapacity:universe];
+    for (NSUInteger i = 0; i < universe; i++) {
+        [keys addObject:[NSString stringWithFormat:@"benchmark.key.%lu", (unsigned long)i]];
+    }
+
+    return keys.copy;
+}
+
+@end
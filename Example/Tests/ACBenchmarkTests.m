@@ -0,0 +1,368 @@
+//
+//  ACBenchmarkTests.m
+//  ACSnippet_Tests
+//
+//  Created by Wenzhi WU on 19/10/2026.
+//  Copyright © 2026 Wenzhi WU. All rights reserved.
+//
+
+@import XCTest;
+#import <ACSnippet/ACLRUCache.h>
+#import <ACSnippet/ACCache.h>
+#import <ACSnippet/ACCachePackWriter.h>
+#import <ACSnippet/ACMercatorProjector.h>
+#import <ACSnippet/ACTileManager.h>
+#import <ACSnippet/ACKeyCounter.h>
+#import <ACSnippet/NSString+HexColor.h>
+#import <ACSnippet/ACBeaconAggregator.h>
+#import "ACBenchmark.h"
+
+/// Key universe of cache workloads
+#define CACHE_KEY_UNIVERSE 10000
+
+/// Memory cache count limit of cache workloads
+#define CACHE_COUNT_LIMIT 2048
+
+/// Operations of cache workloads
+#define CACHE_OPERATIONS 200000
+
+/// Number of keys in style layer counter workloads
+#define COUNTER_KEY_UNIVERSE 5000
+
+/// Stand-in for MGLStyleLayer, counters only read layer identifier
+@interface ACBenchmarkStyleLayer : NSObject
+@property (nonatomic, copy) NSString *identifier;
+@end
+
+@implementation ACBenchmarkStyleLayer
+@end
+
+/// Workloads run without display interaction, results are written by +tearDown to the path in ACSNIPPET_BENCHMARK_OUTPUT
+@interface ACBenchmarkTests : XCTestCase
+
+@end
+
+@implementation ACBenchmarkTests
+
++ (void)tearDown {
+    [[ACBenchmark sharedBenchmark] writeReport];
+    [super tearDown];
+}
+
+#pragma mark - ACLRUCache
+- (void)testLRUCacheUniformGetOrSet {
+    [self runLRUCacheWorkload:@"lru.get_or_set.uniform"
+                      indexes:[ACBenchmarkKeys uniformIndexesWithCount:CACHE_OPERATIONS universe:CACHE_KEY_UNIVERSE seed:7]];
+}
+
+- (void)testLRUCacheZipfianGetOrSet {
+    [self runLRUCacheWorkload:@"lru.get_or_set.zipfian"
+                      indexes:[ACBenchmarkKeys zipfianIndexesWithCount:CACHE_OPERATIONS universe:CACHE_KEY_UNIVERSE exponent:1.0 seed:7]];
+}
+
+- (void)runLRUCacheWorkload:(NSString *)name indexes:(NSData *)data {
+    NSArray <NSString *>*keys = [ACBenchmarkKeys keysWithUniverse:CACHE_KEY_UNIVERSE];
+    const uint32_t *indexes = data.bytes;
+    ACLRUCache *cache = [ACLRUCache new];
+    cache.countLimit = CACHE_COUNT_LIMIT;
+
+    __block NSUInteger hits = 0;
+    [[ACBenchmark sharedBenchmark] measure:name operations:CACHE_OPERATIONS batch:1000 block:^(NSUInteger index) {
+        NSString *key = keys[indexes[index]];
+        if ([cache objectForKey:key]) {
+            hits++;
+        } else {
+            [cache setObject:key forKey:key];
+        }
+    }];
+
+    [[ACBenchmark sharedBenchmark] addCounters:@{@"hit_rate": @((double)hits / CACHE_OPERATIONS)} toResultNamed:name];
+    XCTAssertLessThanOrEqual(cache.totalCount, CACHE_COUNT_LIMIT);
+}
+
+- (void)testLRUCacheSetWithEviction {
+    NSArray <NSString *>*keys = [ACBenchmarkKeys keysWithUniverse:CACHE_KEY_UNIVERSE];
+    ACLRUCache *cache = [ACLRUCache new];
+    cache.countLimit = CACHE_COUNT_LIMIT;
+
+    [[ACBenchmark sharedBenchmark] measure:@"lru.set.evict" operations:CACHE_OPERATIONS batch:1000 block:^(NSUInteger index) {
+        NSString *key = keys[index % CACHE_KEY_UNIVERSE];
+        [cache setObject:key forKey:key];
+    }];
+
+    XCTAssertLessThanOrEqual(cache.totalCount, CACHE_COUNT_LIMIT);
+}
+
+- (void)testLRUCacheTrimToCount {
+    NSArray <NSString *>*keys = [ACBenchmarkKeys keysWithUniverse:CACHE_KEY_UNIVERSE];
+    __block ACLRUCache *cache = nil;
+
+    [[ACBenchmark sharedBenchmark] measure:@"lru.trim.count" operations:20 batch:1 block:^(NSUInteger index) {
+        cache = [ACLRUCache new];
+        for (NSString *key in keys) {
+            [cache setObject:key forKey:key];
+        }
+        cache.countLimit = CACHE_COUNT_LIMIT;
+    }];
+
+    XCTAssertLessThanOrEqual(cache.totalCount, CACHE_COUNT_LIMIT);
+}
+
+#pragma mark - ACCache
+- (void)testDiskCacheRoundTrip {
+    NSString *path = [NSTemporaryDirectory() stringByAppendingPathComponent:@"acsnippet.benchmark.disk"];
+    ACCache *cache = [[ACCache alloc] initWithName:@"benchmark" filePath:path];
+    [cache removeAllObjects];
+
+    NSArray <NSString *>*keys = [ACBenchmarkKeys keysWithUniverse:1000];
+    NSMutableData *payload = [NSMutableData dataWithLength:4096];
+    arc4random_buf(payload.mutableBytes, payload.length);
+
+    [[ACBenchmark sharedBenchmark] measure:@"cache.disk.set" operations:2000 batch:10 block:^(NSUInteger index) {
+        [cache.diskCache setObject:payload forKey:keys[index % keys.count]];
+    }];
+
+    __block NSUInteger misses = 0;
+    [[ACBenchmark sharedBenchmark] measure:@"cache.disk.get" operations:2000 batch:10 block:^(NSUInteger index) {
+        if (![cache.diskCache objectForKey:keys[index % keys.count]]) misses++;
+    }];
+
+    [cache removeAllObjects];
+    XCTAssertEqual(misses, 0);
+}
+
+- (void)testDiskCacheQuotaEviction {
+    NSString *path = [NSTemporaryDirectory() stringByAppendingPathComponent:@"acsnippet.benchmark.quota"];
+    ACCache *cache = [[ACCache alloc] initWithName:@"quota" filePath:path];
+    [cache removeAllObjects];
+    cache.diskCountLimit = 500;
+
+    NSArray <NSString *>*keys = [ACBenchmarkKeys keysWithUniverse:2000];
+    NSMutableData *payload = [NSMutableData dataWithLength:1024];
+    arc4random_buf(payload.mutableBytes, payload.length);
+
+    // every tenth object is a low zoom tile worth keeping
+    [[ACBenchmark sharedBenchmark] measure:@"cache.disk.set.quota" operations:2000 batch:10 block:^(NSUInteger index) {
+        [cache setObject:payload forKey:keys[index] priority:index % 10 == 0 ? 5 : 0];
+    }];
+
+    NSDate *deadline = [NSDate dateWithTimeIntervalSinceNow:30];
+    while (cache.diskCache.totalCount > 500 && [deadline timeIntervalSinceNow] > 0) {
+        [NSThread sleepForTimeInterval:0.05];
+    }
+
+    NSUInteger kept = 0;
+    for (NSUInteger i = 0; i < 2000; i += 10) {
+        if ([cache.diskCache containsObjectForKey:keys[i]]) kept++;
+    }
+
+    [[ACBenchmark sharedBenchmark] addCounters:@{@"disk_count": @(cache.diskCache.totalCount), @"priority_kept": @(kept)} toResultNamed:@"cache.disk.set.quota"];
+    XCTAssertLessThanOrEqual(cache.diskCache.totalCount, 500);
+    XCTAssertEqual(kept, 200);
+    [cache removeAllObjects];
+}
+
+- (void)testCachePackLookup {
+    NSString *path = [NSTemporaryDirectory() stringByAppendingPathComponent:@"acsnippet.benchmark.pack"];
+    NSArray <NSString *>*keys = [ACBenchmarkKeys keysWithUniverse:CACHE_KEY_UNIVERSE];
+    NSMutableData *payload = [NSMutableData dataWithLength:1024];
+    arc4random_buf(payload.mutableBytes, payload.length);
+    NSData *archived = [NSKeyedArchiver archivedDataWithRootObject:payload];
+
+    ACCachePackWriter *writer = [ACCachePackWriter new];
+    [[ACBenchmark sharedBenchmark] measure:@"cache.pack.write" operations:CACHE_KEY_UNIVERSE batch:100 block:^(NSUInteger index) {
+        [writer addData:archived forKey:keys[index] version:@"1"];
+    }];
+    XCTAssertTrue([writer writeToFile:path error:nil]);
+
+    ACCachePack *pack = [ACCachePack packWithContentsOfFile:path error:nil];
+    XCTAssertEqual(pack.count, CACHE_KEY_UNIVERSE);
+
+    NS_VALID_UNTIL_END_OF_SCOPE NSData *data = [ACBenchmarkKeys zipfianIndexesWithCount:CACHE_OPERATIONS universe:CACHE_KEY_UNIVERSE exponent:1.0 seed:7];
+    const uint32_t *indexes = data.bytes;
+    __block NSUInteger bytes = 0;
+    [[ACBenchmark sharedBenchmark] measure:@"cache.pack.data_for_key" operations:CACHE_OPERATIONS batch:1000 block:^(NSUInteger index) {
+        bytes += [pack dataForKey:keys[indexes[index]]].length;
+    }];
+
+    ACCache *cache = [[ACCache alloc] initWithName:@"pack" filePath:[path stringByAppendingString:@".cache"]];
+    [cache removeAllObjects];
+    [cache attachPack:pack];
+    [[ACBenchmark sharedBenchmark] measure:@"cache.pack.object_for_key" operations:CACHE_OPERATIONS / 10 batch:100 block:^(NSUInteger index) {
+        [cache objectForKey:keys[indexes[index]]];
+    }];
+
+    XCTAssertEqual(bytes, archived.length * CACHE_OPERATIONS);
+    [cache removeAllObjects];
+    [[NSFileManager defaultManager] removeItemAtPath:path error:nil];
+}
+
+#pragma mark - ACMercatorProjector
+- (void)testProjectorBulkConversion {
+    NSUInteger count = 100000;
+    CLLocationCoordinate2D *coordinates = malloc(count * sizeof(CLLocationCoordinate2D));
+    NS_VALID_UNTIL_END_OF_SCOPE NSData *random = [ACBenchmarkKeys uniformIndexesWithCount:count * 2 universe:100000 seed:11];
+    const uint32_t *values = random.bytes;
+    for (NSUInteger i = 0; i < count; i++) {
+        coordinates[i] = CLLocationCoordinate2DMake(22.20 + values[i * 2] / 1000000.0, 114.10 + values[i * 2 + 1] / 1000000.0);
+    }
+
+    ACMercatorProjector *projector = [[ACMercatorProjector alloc] initWithTileSize:256];
+    __block CGPoint sink = CGPointZero;
+    [[ACBenchmark sharedBenchmark] measure:@"projector.to_meters" operations:count batch:1000 block:^(NSUInteger index) {
+        sink = [projector coordinateToMeters:coordinates[index]];
+    }];
+
+    CGPoint meters = sink;
+    [[ACBenchmark sharedBenchmark] measure:@"projector.to_coordinate" operations:count batch:1000 block:^(NSUInteger index) {
+        [projector metersToCoordinate:CGPointMake(meters.x + index, meters.y)];
+    }];
+
+    [[ACBenchmark sharedBenchmark] measure:@"projector.tile_xy.z18" operations:count batch:1000 block:^(NSUInteger index) {
+        sink = [projector tileXYWithZoom:18 atCoordinate:coordinates[index]];
+    }];
+
+    [[ACBenchmark sharedBenchmark] measure:@"projector.tile_region.z18" operations:count / 10 batch:100 block:^(NSUInteger index) {
+        [projector tileWithZoom:18 atCoordinate:coordinates[index]];
+    }];
+
+    free(coordinates);
+}
+
+#pragma mark - ACTileCollection
+- (void)testTileCollectionPanTrace {
+    ACTileManager *manager = [[ACTileManager alloc] initWithHightDPITileImages:NO];
+    __block ACTileCollection *previous = nil;
+    __block NSUInteger entered = 0;
+
+    // camera pans east along Hong Kong island, roughly a quarter tile per frame at zoom 17
+    [[ACBenchmark sharedBenchmark] measure:@"tile.collection.pan" operations:5000 batch:50 block:^(NSUInteger index) {
+        CLLocationCoordinate2D center = CLLocationCoordinate2DMake(22.2800, 114.1300 + index * 0.0007);
+        ACTileCollection *collection = [manager tileCollectionWithZoom:17 atCoordinate:center withDimension:7];
+        ACTileCollectionChanges *changes = [collection changesFrom:previous];
+        entered += changes.entered.count;
+        previous = collection;
+    }];
+
+    [[ACBenchmark sharedBenchmark] addCounters:@{@"entered_per_op": @((double)entered / 5000)} toResultNamed:@"tile.collection.pan"];
+}
+
+- (void)testTileCollectionZoomTrace {
+    ACTileManager *manager = [[ACTileManager alloc] initWithHightDPITileImages:NO];
+    CLLocationCoordinate2D center = CLLocationCoordinate2DMake(22.2830, 114.1371);
+    __block ACTileCollection *previous = nil;
+
+    // zoom in and out between 14 and 19
+    [[ACBenchmark sharedBenchmark] measure:@"tile.collection.zoom" operations:5000 batch:50 block:^(NSUInteger index) {
+        NSUInteger step = index % 10;
+        NSUInteger zoom = 14 + (step < 5 ? step : 10 - step);
+        ACTileCollection *collection = [manager tileCollectionWithZoom:zoom atCoordinate:center withDimension:7];
+        [collection changesFrom:previous];
+        previous = collection;
+    }];
+}
+
+- (void)testTileRegionLookup {
+    ACTileManager *manager = [[ACTileManager alloc] initWithHightDPITileImages:NO];
+    NSMutableArray <NSString *>*codes = @[].mutableCopy;
+    for (NSUInteger x = 0; x < 40; x++) {
+        for (NSUInteger y = 0; y < 40; y++) {
+            [codes addObject:[manager tileCodeWithZoom:18 x:214000 + x y:114000 + y]];
+        }
+    }
+
+    NS_VALID_UNTIL_END_OF_SCOPE NSData *data = [ACBenchmarkKeys zipfianIndexesWithCount:100000 universe:codes.count exponent:1.0 seed:5];
+    const uint32_t *indexes = data.bytes;
+    [manager.regionCache resetStatistics];
+    [[ACBenchmark sharedBenchmark] measure:@"tile.region.lookup.zipfian" operations:100000 batch:1000 block:^(NSUInteger index) {
+        [manager tileWithTileCode:codes[indexes[index]]];
+    }];
+
+    [[ACBenchmark sharedBenchmark] addCounters:@{@"hit_rate": @(manager.regionCache.hitRate),
+                                                 @"region_allocations": @(manager.regionCache.allocationCount)}
+                                 toResultNamed:@"tile.region.lookup.zipfian"];
+}
+
+#pragma mark - ACKeyCounter
+- (void)testKeyCounterLookupAndChurn {
+    NSArray <NSString *>*keys = [ACBenchmarkKeys keysWithUniverse:COUNTER_KEY_UNIVERSE];
+    NSMutableArray <NSArray *>*layers = [NSMutableArray arrayWithCapacity:COUNTER_KEY_UNIVERSE];
+    for (NSString *key in keys) {
+        ACBenchmarkStyleLayer *fill = [ACBenchmarkStyleLayer new];
+        fill.identifier = [key stringByAppendingString:@".fill"];
+        ACBenchmarkStyleLayer *line = [ACBenchmarkStyleLayer new];
+        line.identifier = [key stringByAppendingString:@".line"];
+        [layers addObject:@[fill, line]];
+    }
+
+    ACKeyCounter *counter = [[ACKeyCounter alloc] initWithType:@"benchmark"];
+    [[ACBenchmark sharedBenchmark] measure:@"counter.key.add" operations:COUNTER_KEY_UNIVERSE batch:100 block:^(NSUInteger index) {
+        [counter addKey:keys[index] withStyleLayers:(NSArray <MGLStyleLayer *>*)layers[index]];
+    }];
+
+    NS_VALID_UNTIL_END_OF_SCOPE NSData *data = [ACBenchmarkKeys uniformIndexesWithCount:50000 universe:COUNTER_KEY_UNIVERSE seed:3];
+    const uint32_t *indexes = data.bytes;
+    __block NSUInteger misses = 0;
+    [[ACBenchmark sharedBenchmark] measure:@"counter.key.lookup" operations:50000 batch:500 block:^(NSUInteger index) {
+        if (![counter layerIdentifiersForKey:keys[indexes[index]]]) misses++;
+    }];
+
+    // remove and add back, the way layers of a tile are replaced on refresh
+    [[ACBenchmark sharedBenchmark] measure:@"counter.key.churn" operations:50000 batch:500 block:^(NSUInteger index) {
+        NSUInteger key = indexes[index];
+        [counter removeKey:keys[key]];
+        [counter addKey:keys[key] withStyleLayers:(NSArray <MGLStyleLayer *>*)layers[key]];
+        [counter lastLayerIdentifier];
+    }];
+
+    XCTAssertEqual(misses, 0);
+    XCTAssertFalse([counter isEmpty]);
+    XCTAssertEqualObjects([counter lastLayerIdentifier], [keys[indexes[49999]] stringByAppendingString:@".line"]);
+}
+
+#pragma mark - NSString+HexColor
+- (void)testHexColorStyleLoad {
+    // a style reload parses a few hundred distinct colors thousands of times
+    NSMutableArray <NSString *>*colors = [NSMutableArray arrayWithCapacity:300];
+    for (NSUInteger i = 0; i < 300; i++) {
+        [colors addObject:[NSString stringWithFormat:i % 2 ? @"#%06lX" : @"#FF%06lX", (unsigned long)(i * 0x010203)]];
+    }
+
+    NS_VALID_UNTIL_END_OF_SCOPE NSData *data = [ACBenchmarkKeys zipfianIndexesWithCount:100000 universe:colors.count exponent:1.0 seed:13];
+    const uint32_t *indexes = data.bytes;
+    [[ACBenchmark sharedBenchmark] measure:@"hexcolor.parse.zipfian" operations:100000 batch:1000 block:^(NSUInteger index) {
+        [colors[indexes[index]] hexColor];
+    }];
+}
+
+#pragma mark - ACBeaconAggregator
+- (void)testBeaconAggregatorReplay {
+    // 60 beacons ranged at 1 Hz for an hour, about a third of them out of range at any time
+    NSUInteger beacons = 60, ticks = 3600;
+    NSUUID *uuid = [[NSUUID alloc] initWithUUIDString:@"FDA50693-A4E2-4FB1-AFCF-C6EB07647825"];
+    NSMutableData *buffer = [NSMutableData dataWithLength:beacons * ticks * sizeof(ACBeaconSample)];
+    ACBeaconSample *samples = buffer.mutableBytes;
+    NS_VALID_UNTIL_END_OF_SCOPE NSData *random = [ACBenchmarkKeys uniformIndexesWithCount:beacons * ticks universe:100 seed:17];
+    const uint32_t *noise = random.bytes;
+    NSUInteger count = 0;
+    for (NSUInteger t = 0; t < ticks; t++) {
+        for (NSUInteger b = 0; b < beacons; b++) {
+            if ((b + t / 120) % 3 == 0) continue;
+
+            uint32_t value = noise[t * beacons + b];
+            samples[count++] = ACBeaconSampleMake(ACBeaconIdentityMake(uuid, 100, (uint16_t)b), -60 - (NSInteger)(value % 30), 0.5 + value / 20.0, t);
+        }
+    }
+
+    ACBeaconAggregator *aggregator = [[ACBeaconAggregator alloc] initWithCapacity:64];
+    [[ACBenchmark sharedBenchmark] measure:@"beacon.ingest.replay" operations:count batch:beacons block:^(NSUInteger index) {
+        [aggregator ingestSamples:&samples[index] count:1];
+    }];
+
+    ACBeaconEstimate estimates[64];
+    NSUInteger tracked = [aggregator getEstimates:estimates maxCount:64];
+    [[ACBenchmark sharedBenchmark] addCounters:@{@"tracked_beacons": @(tracked)} toResultNamed:@"beacon.ingest.replay"];
+    XCTAssertLessThanOrEqual(tracked, beacons);
+}
+
+@end
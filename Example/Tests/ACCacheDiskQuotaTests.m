@@ -0,0 +1,84 @@
+//
+//  ACCacheDiskQuotaTests.m
+//  ACSnippet_Tests
+//
+//  Created by Wenzhi WU on 19/10/2026.
+//  Copyright © 2026 Wenzhi WU. All rights reserved.
+//
+
+@import XCTest;
+#import <ACSnippet/ACCache.h>
+#import <ACSnippet/ACCacheDiskIndex.h>
+
+@interface ACCacheDiskQuotaTests : XCTestCase
+@property (nonatomic, copy) NSString *path;
+@end
+
+@implementation ACCacheDiskQuotaTests
+
+- (void)setUp {
+    [super setUp];
+    _path = [NSTemporaryDirectory() stringByAppendingPathComponent:[NSString stringWithFormat:@"quota.%@", [NSUUID UUID].UUIDString]];
+}
+
+- (void)tearDown {
+    [[NSFileManager defaultManager] removeItemAtPath:_path error:nil];
+    [super tearDown];
+}
+
+- (void)testObjectsStoredWithoutIndexAreEvictedFirst {
+    // objects written before disk index existed
+    YYDiskCache *legacy = [[YYDiskCache alloc] initWithPath:_path];
+    for (NSUInteger i = 0; i < 300; i++) {
+        [legacy setObject:@(i) forKey:[NSString stringWithFormat:@"legacy.%lu", (unsigned long)i]];
+    }
+    legacy = nil;
+    // YYKVStorage keeps access time in seconds
+    [NSThread sleepForTimeInterval:1.1];
+
+    ACCache *cache = [[ACCache alloc] initWithName:@"quota" filePath:_path];
+    for (NSUInteger i = 0; i < 100; i++) {
+        [cache setObject:@(i) forKey:[NSString stringWithFormat:@"tile.%lu", (unsigned long)i] priority:5];
+    }
+    cache.diskCountLimit = 200;
+
+    NSDate *deadline = [NSDate dateWithTimeIntervalSinceNow:10];
+    while (cache.diskCache.totalCount > 200 && [deadline timeIntervalSinceNow] > 0) {
+        [NSThread sleepForTimeInterval:0.05];
+    }
+
+    XCTAssertLessThanOrEqual(cache.diskCache.totalCount, 200);
+    for (NSUInteger i = 0; i < 100; i++) {
+        XCTAssertTrue([cache.diskCache containsObjectForKey:[NSString stringWithFormat:@"tile.%lu", (unsigned long)i]]);
+    }
+}
+
+- (void)testMemoryHitDoesNotIndexKeyMissingFromDisk {
+    ACCacheDiskIndex *index = [[ACCacheDiskIndex alloc] initWithPath:[_path stringByAppendingPathComponent:@"index.plist"]];
+    [index touchKeyIfIndexed:@"tile.1"];
+    XCTAssertEqual(index.count, 0);
+
+    [index touchKey:@"tile.1"];
+    [index touchKeyIfIndexed:@"tile.1"];
+    XCTAssertEqual(index.count, 1);
+}
+
+- (void)testEvictionKeepsKeyWrittenAfterSnapshot {
+    ACCacheDiskIndex *index = [[ACCacheDiskIndex alloc] initWithPath:[_path stringByAppendingPathComponent:@"index.plist"]];
+    [index touchKey:@"tile.1"];
+    [index touchKey:@"tile.2"];
+    NSTimeInterval snapshot = [[NSDate date] timeIntervalSince1970];
+    [NSThread sleepForTimeInterval:0.01];
+
+    // tile.2 is written again between ordering and removal, tile.3 is not indexed
+    [index touchKey:@"tile.2"];
+    NSMutableArray *removed = @[].mutableCopy;
+    NSArray *keys = [index removeKeys:@[@"tile.1", @"tile.2", @"tile.3"] notAccessedAfter:snapshot usingBlock:^(NSString *key) {
+        [removed addObject:key];
+    }];
+    XCTAssertEqualObjects(keys, @[@"tile.1"]);
+    XCTAssertEqualObjects(removed, @[@"tile.1"]);
+    XCTAssertEqual(index.count, 1);
+}
+
+@end
@@ -0,0 +1,156 @@
+//
+//  ACCacheEventCoalescerTests.m
+//  ACSnippet_Tests
+//
+//  Created by Wenzhi WU on 19/10/2026.
+//  Copyright © 2026 Wenzhi WU. All rights reserved.
+//
+
+@import XCTest;
+#import <ACSnippet/ACCacheEventCoalescer.h>
+#import <ACSnippet/ACLRUCache.h>
+#import "ACSimulatedDownloader.h"
+
+@interface ACCacheEventCoalescerTests : XCTestCase <ACLRUCacheDelegate>
+@property (nonatomic, strong) NSMutableArray <ACCacheEventBatch *> *batches;
+@property (nonatomic, strong) NSMutableArray <NSArray <NSString *> *> *trims;
+@property (nonatomic, strong) NSMutableArray <NSNumber *> *trimsOnMainThread;
+@end
+
+@implementation ACCacheEventCoalescerTests
+
+- (void)setUp {
+    [super setUp];
+    _batches = @[].mutableCopy;
+    _trims = @[].mutableCopy;
+    _trimsOnMainThread = @[].mutableCopy;
+}
+
+- (ACCacheEventCoalescer *)coalescerWithInterval:(NSTimeInterval)interval {
+    __weak typeof(self) _self = self;
+    return [[ACCacheEventCoalescer alloc] initWithInterval:interval deliveryHandler:^(ACCacheEventBatch *batch) {
+        [_self.batches addObject:batch];
+    }];
+}
+
+/// Spin main run loop until condition holds or timeout
+- (BOOL)waitUntil:(BOOL (^)(void))condition timeout:(NSTimeInterval)timeout {
+    NSDate *deadline = [NSDate dateWithTimeIntervalSinceNow:timeout];
+    while (!condition()) {
+        if ([deadline timeIntervalSinceNow] <= 0) return NO;
+        [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.01]];
+    }
+
+    return YES;
+}
+
+- (void)testConcurrentEventsAreFoldedAndDeduplicated {
+    ACCacheEventCoalescer *coalescer = [self coalescerWithInterval:0.2];
+    dispatch_apply(500, dispatch_get_global_queue(0, 0), ^(size_t i) {
+        [coalescer addUpdatedKeys:@[[NSString stringWithFormat:@"tile.%zu", i % 50]]];
+    });
+
+    XCTAssertTrue([self waitUntil:^BOOL{
+        NSUInteger events = 0;
+        for (ACCacheEventBatch *batch in self.batches) events += batch.eventCount;
+        return events == 500;
+    } timeout:5]);
+
+    NSMutableSet *keys = [NSMutableSet set];
+    for (ACCacheEventBatch *batch in _batches) {
+        XCTAssertEqual(batch.updatedKeys.count, [NSSet setWithArray:batch.updatedKeys].count);
+        [keys addObjectsFromArray:batch.updatedKeys];
+    }
+    XCTAssertEqual(keys.count, 50);
+    XCTAssertLessThanOrEqual(_batches.count, 3);
+    XCTAssertEqual(coalescer.receivedEventCount, 500);
+    XCTAssertEqual(coalescer.deliveredBatchCount, _batches.count);
+    XCTAssertEqual(coalescer.foldedEventCount, 500 - _batches.count);
+}
+
+- (void)testRetryClearsPendingFailure {
+    ACCacheEventCoalescer *coalescer = [self coalescerWithInterval:1];
+    NSError *error = [NSError errorWithDomain:@"test" code:1 userInfo:nil];
+    [coalescer addFailedKeys:@[@"floor.1", @"floor.2"] withError:error];
+    [coalescer addFailedKeys:@[@"floor.2"] withError:error];
+    [coalescer addRetryObjects:@[[[ACSimulatedObject alloc] initWithObjectID:@"floor.1" version:@"1" payload:[NSData data]]]];
+    [coalescer flush];
+
+    XCTAssertTrue([self waitUntil:^BOOL{ return self.batches.count == 1; } timeout:2]);
+    ACCacheEventBatch *batch = _batches.firstObject;
+    XCTAssertEqualObjects(batch.failedKeys[error], @[@"floor.2"]);
+    XCTAssertEqualObjects([batch.retryObjects.firstObject objectID], @"floor.1");
+    XCTAssertEqual(batch.eventCount, 3);
+    XCTAssertEqual(coalescer.duplicateKeyCount, 1);
+}
+
+- (void)testOnlyLaterSuccessCancelsPendingEvent {
+    ACCacheEventCoalescer *coalescer = [self coalescerWithInterval:1];
+    NSError *error = [NSError errorWithDomain:@"test" code:1 userInfo:nil];
+    ACSimulatedObject *object = [[ACSimulatedObject alloc] initWithObjectID:@"tile.4" version:@"1" payload:[NSData data]];
+    // trims and failures keep the stored update and retry
+    [coalescer addUpdatedKeys:@[@"tile.1", @"tile.2"]];
+    [coalescer addTrimmedKeys:@[@"tile.1"]];
+    [coalescer addFailedKeys:@[@"tile.2"] withError:error];
+    [coalescer addRetryObjects:@[object]];
+    [coalescer addTrimmedKeys:@[@"tile.4"]];
+    // an update cancels failure and trim, a retry only the failure
+    [coalescer addFailedKeys:@[@"tile.3", @"tile.5"] withError:error];
+    [coalescer addTrimmedKeys:@[@"tile.3"]];
+    [coalescer addUpdatedKeys:@[@"tile.3"]];
+    [coalescer addRetryObjects:@[[[ACSimulatedObject alloc] initWithObjectID:@"tile.5" version:@"1" payload:[NSData data]]]];
+    [coalescer flush];
+
+    XCTAssertTrue([self waitUntil:^BOOL{ return self.batches.count == 1; } timeout:2]);
+    ACCacheEventBatch *batch = _batches.firstObject;
+    XCTAssertEqualObjects(batch.updatedKeys, (@[@"tile.1", @"tile.2", @"tile.3"]));
+    XCTAssertEqualObjects(batch.trimmedKeys, (@[@"tile.1", @"tile.4"]));
+    XCTAssertEqualObjects(batch.failedKeys[error], @[@"tile.2"]);
+    XCTAssertEqualObjects([batch.retryObjects valueForKey:@"objectID"], (@[@"tile.4", @"tile.5"]));
+    XCTAssertEqual(batch.eventCount, 9);
+    XCTAssertEqual(coalescer.cancelledKeyCount, 3);
+}
+
+#pragma mark - ACLRUCache
+- (void)lruCache:(ACLRUCache *)cache didTrimObjectsForKeys:(NSArray<NSString *> *)keys {
+    BOOL mainThread = [NSThread isMainThread];
+    dispatch_async(dispatch_get_main_queue(), ^{
+        [self.trims addObject:keys];
+        [self.trimsOnMainThread addObject:@(mainThread)];
+    });
+}
+
+- (ACLRUCache *)trimmedCacheNotifyingOnTrimmingThread:(BOOL)trimmingThread {
+    ACLRUCache *cache = [ACLRUCache new];
+    cache.delegate = self;
+    cache.notifiesTrimsOnTrimmingThread = trimmingThread;
+    for (NSUInteger i = 0; i < 100; i++) {
+        [cache setObject:@(i) forKey:[NSString stringWithFormat:@"tile.%lu", (unsigned long)i] cost:1];
+    }
+
+    cache.costLimit = 10;
+    [cache trimInBackground];
+    return cache;
+}
+
+- (void)testLRUCacheReportsTrimOnceOnMainThread {
+    ACLRUCache *cache = [self trimmedCacheNotifyingOnTrimmingThread:NO];
+
+    XCTAssertTrue([self waitUntil:^BOOL{ return self.trims.count > 0; } timeout:2]);
+    [self waitUntil:^BOOL{ return NO; } timeout:0.1];
+    XCTAssertEqual(_trims.count, 1);
+    XCTAssertEqual(_trims.firstObject.count, 90);
+    XCTAssertEqualObjects(_trims.firstObject.firstObject, @"tile.0");
+    XCTAssertEqualObjects(_trimsOnMainThread, @[@YES]);
+    XCTAssertEqual(cache.totalCount, 10);
+}
+
+- (void)testLRUCacheReportsTrimOnTrimmingThreadWhenAsked {
+    [self trimmedCacheNotifyingOnTrimmingThread:YES];
+
+    XCTAssertTrue([self waitUntil:^BOOL{ return self.trims.count > 0; } timeout:2]);
+    XCTAssertEqual(_trims.firstObject.count, 90);
+    XCTAssertEqualObjects(_trimsOnMainThread, @[@NO]);
+}
+
+@end
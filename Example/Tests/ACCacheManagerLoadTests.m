@@ -0,0 +1,223 @@
+//
+//  ACCacheManagerLoadTests.m
+//  ACSnippet_Tests
+//
+//  Created by Wenzhi WU on 19/10/2026.
+//  Copyright © 2026 Wenzhi WU. All rights reserved.
+//
+
+@import XCTest;
+#import <ACSnippet/ACCacheManager.h>
+#import <stdatomic.h>
+#import "ACBenchmark.h"
+#import "ACSimulatedDownloader.h"
+
+/// Keys requested by each batch request
+static const NSUInteger ACLoadBatchKeyCount = 8;
+
+/// Drives concurrent requests against ACCacheManager backed by ACSimulatedDownloader, runs headless and reports through ACBenchmark
+///
+/// A request is lost when it never gets a callback. objectForKey:completionHandler: returns without calling handler when key is
+/// already in downloading, and objectsForKeys:storageHandler:requestCompletionHandler: leaves keys in downloading unresolved,
+/// so lost callbacks and unresolved keys are expected to be non-zero under contention.
+@interface ACCacheManagerLoadTests : XCTestCase
+@property (nonatomic, strong) ACSimulatedDownloader *downloader;
+@property (nonatomic, strong) ACCacheManager *manager;
+@end
+
+@implementation ACCacheManagerLoadTests
+
++ (void)tearDown {
+    [[ACBenchmark sharedBenchmark] writeReport];
+    [super tearDown];
+}
+
+- (void)setUp {
+    [super setUp];
+    _downloader = [[ACSimulatedDownloader alloc] initWithSeed:7];
+    NSString *name = [NSString stringWithFormat:@"load.%@", [NSUUID UUID].UUIDString];
+    _manager = [[ACCacheManager alloc] initWithName:name downloader:_downloader cacheToDisk:NO refreshInterval:3600];
+    _manager.avoidVersionCheckout = YES;
+}
+
+- (void)tearDown {
+    [_manager.storage removeAllObjects];
+    _manager = nil;
+    _downloader = nil;
+    [super tearDown];
+}
+
+/// Spin main run loop until condition holds or timeout, main queue callbacks are delivered meanwhile
+- (BOOL)waitUntil:(BOOL (^)(void))condition timeout:(NSTimeInterval)timeout {
+    NSDate *deadline = [NSDate dateWithTimeIntervalSinceNow:timeout];
+    while (!condition()) {
+        if ([deadline timeIntervalSinceNow] <= 0) return NO;
+        [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.01]];
+    }
+
+    return YES;
+}
+
+#pragma mark - Load
+- (void)testConcurrentRequestsAgainstSimulatedDownloader {
+    NSUInteger requests = 4000;
+    NSUInteger universe = 1000;
+    NSArray <NSString *>*keys = [ACBenchmarkKeys keysWithUniverse:universe];
+    // key stream is read through its bytes by every request block, keep it until the end of the test
+    NS_VALID_UNTIL_END_OF_SCOPE NSData *stream = [ACBenchmarkKeys zipfianIndexesWithCount:requests * ACLoadBatchKeyCount universe:universe exponent:1.0 seed:11];
+    const uint32_t *indexes = stream.bytes;
+
+    _downloader.medianLatency = 0.02;
+    _downloader.latencySpread = 0.6;
+    _downloader.failureRate = 0.02;
+    _downloader.maximumBatchSize = 4;
+
+    // every 8th request is a batch request, the rest are single key requests
+    uint64_t *starts = calloc(requests, sizeof(uint64_t));
+    double *latencies = calloc(requests, sizeof(double));
+    _Atomic uint32_t *callbacks = calloc(requests, sizeof(_Atomic uint32_t));
+    _Atomic uint32_t *resolved = calloc(requests, sizeof(_Atomic uint32_t));
+    __block _Atomic NSUInteger completed = 0;
+    __block _Atomic NSUInteger errors = 0;
+    ACCacheManager *manager = _manager;
+
+    void (^finish)(NSUInteger, NSUInteger) = ^(NSUInteger request, NSUInteger keyCount) {
+        atomic_fetch_add(&resolved[request], (uint32_t)keyCount);
+        if (atomic_fetch_add(&callbacks[request], 1) == 0) {
+            latencies[request] = (double)(ACBenchmarkTimestamp() - starts[request]);
+            atomic_fetch_add(&completed, 1);
+        }
+    };
+
+    uint64_t start = ACBenchmarkTimestamp();
+    dispatch_apply(requests, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^(size_t i) {
+        starts[i] = ACBenchmarkTimestamp();
+        if (i % 8 == 7) {
+            NSMutableArray *batch = [NSMutableArray arrayWithCapacity:ACLoadBatchKeyCount];
+            for (NSUInteger k = 0; k < ACLoadBatchKeyCount; k++) {
+                [batch addObject:keys[indexes[i * ACLoadBatchKeyCount + k]]];
+            }
+
+            [manager objectsForKeys:batch storageHandler:^(NSArray<ACCacheObject> *objects) {
+                finish(i, objects.count);
+            } requestCompletionHandler:^(NSError *error, NSArray<NSString *> *requested, NSArray<ACCacheObject> *objects) {
+                if (error) atomic_fetch_add(&errors, 1);
+                finish(i, requested.count);
+            }];
+        } else {
+            [manager objectForKey:keys[indexes[i * ACLoadBatchKeyCount]] completionHandler:^(NSError *error, id<ACCacheObject> cache) {
+                if (error) atomic_fetch_add(&errors, 1);
+                finish(i, 1);
+            }];
+        }
+    });
+
+    // stop once downloader is idle and no callback arrived for a while, remaining requests are lost
+    __block NSUInteger progress = 0;
+    __block NSDate *stalled = [NSDate date];
+    [self waitUntil:^BOOL{
+        NSUInteger current = atomic_load(&completed);
+        if (current == requests) return YES;
+        if (current != progress || [manager.downloader.keysInDownloading count]) {
+            progress = current;
+            stalled = [NSDate date];
+        }
+
+        return [stalled timeIntervalSinceNow] < -0.5;
+    } timeout:30];
+    double elapsed = (double)(ACBenchmarkTimestamp() - start);
+
+    NSUInteger answered = 0, duplicated = 0, unresolved = 0;
+    for (NSUInteger i = 0; i < requests; i++) {
+        uint32_t count = atomic_load(&callbacks[i]);
+        if (count) latencies[answered++] = latencies[i];
+        if (i % 8 == 7) {
+            uint32_t keyCount = atomic_load(&resolved[i]);
+            unresolved += keyCount < ACLoadBatchKeyCount ? ACLoadBatchKeyCount - keyCount : 0;
+        } else if (count > 1) {
+            duplicated++;
+        }
+    }
+
+    NSString *name = @"cache.manager.load.zipf";
+    [[ACBenchmark sharedBenchmark] recordResultNamed:name elapsed:elapsed latencies:latencies count:answered];
+    [[ACBenchmark sharedBenchmark] addCounters:@{@"requests": @(requests),
+                                                 @"throughput_per_s": @(answered / (elapsed / NSEC_PER_SEC)),
+                                                 @"errors": @(atomic_load(&errors)),
+                                                 @"lost_callbacks": @(requests - answered),
+                                                 @"unresolved_batch_keys": @(unresolved),
+                                                 @"download_requests": @(_downloader.requestCount),
+                                                 @"downloaded_keys": @(_downloader.downloadedKeyCount),
+                                                 @"duplicate_downloads": @(_downloader.duplicateDownloadCount),
+                                                 @"delegate_events": @(_manager.eventCoalescer.receivedEventCount),
+                                                 @"delegate_batches": @(_manager.eventCoalescer.deliveredBatchCount),
+                                                 @"delegate_events_folded": @(_manager.eventCoalescer.foldedEventCount)}
+                                 toResultNamed:name];
+
+    XCTAssertEqual(duplicated, 0, @"single key handler should not be called twice");
+    XCTAssertGreaterThan(answered, 0);
+
+    free(starts);
+    free(latencies);
+    free(callbacks);
+    free(resolved);
+}
+
+#pragma mark - Behaviour
+- (void)testConcurrentRequestsForDownloadingKey {
+    _downloader.medianLatency = 0.1;
+    _downloader.latencySpread = 0;
+
+    __block NSUInteger callbacks = 0;
+    for (NSUInteger i = 0; i < 2; i++) {
+        [_manager objectForKey:@"floor.1" completionHandler:^(NSError *error, id<ACCacheObject> cache) {
+            dispatch_async(dispatch_get_main_queue(), ^{
+                callbacks++;
+            });
+        }];
+    }
+
+    [self waitUntil:^BOOL{ return callbacks == 2; } timeout:0.5];
+
+    // the second handler is currently dropped while the key is downloading, reported rather than asserted
+    NSString *name = @"cache.manager.downloading_key";
+    [[ACBenchmark sharedBenchmark] recordResultNamed:name elapsed:0 latencies:NULL count:0];
+    [[ACBenchmark sharedBenchmark] addCounters:@{@"requests": @2, @"lost_callbacks": @(2 - callbacks)} toResultNamed:name];
+
+    XCTAssertGreaterThanOrEqual(callbacks, 1);
+    XCTAssertEqual(_downloader.requestCount, 1);
+    XCTAssertTrue([_manager containsObjectForKey:@"floor.1"]);
+}
+
+- (void)testFailedDownloadReportsError {
+    _downloader.medianLatency = 0.01;
+    _downloader.failureRate = 1;
+
+    __block NSError *failure = nil;
+    [_manager objectForKey:@"floor.1" completionHandler:^(NSError *error, id<ACCacheObject> cache) {
+        dispatch_async(dispatch_get_main_queue(), ^{
+            failure = error;
+        });
+    }];
+
+    XCTAssertTrue([self waitUntil:^BOOL{ return failure != nil; } timeout:2]);
+    XCTAssertFalse([_manager containsObjectForKey:@"floor.1"]);
+    XCTAssertEqual(_downloader.failureCount, 1);
+}
+
+- (void)testVersionChurn {
+    _downloader.medianLatency = 0.01;
+    _downloader.versionChurnRate = 1;
+
+    __block NSDictionary *versions = nil;
+    [_downloader checkoutObjectVesionsForKeys:@[@"floor.1"] completionHandler:^(NSError *error, NSDictionary *result, NSArray<NSString *> *keys) {
+        dispatch_async(dispatch_get_main_queue(), ^{
+            versions = result;
+        });
+    }];
+
+    XCTAssertTrue([self waitUntil:^BOOL{ return versions != nil; } timeout:2]);
+    XCTAssertEqualObjects(versions[@"floor.1"], @"2");
+}
+
+@end
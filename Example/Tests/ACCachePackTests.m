@@ -0,0 +1,186 @@
+//
+//  ACCachePackTests.m
+//  ACSnippet_Tests
+//
+//  Created by Wenzhi WU on 19/10/2026.
+//  Copyright © 2026 Wenzhi WU. All rights reserved.
+//
+
+@import XCTest;
+#import <ACSnippet/ACCacheManager.h>
+#import <ACSnippet/ACCachePackWriter.h>
+#import <ACSnippet/ACCachePackFormat.h>
+#import "ACSimulatedDownloader.h"
+#import <Reachability/Reachability.h>
+
+@interface ACCachePackTests : XCTestCase
+@property (nonatomic, copy) NSString *path;
+@end
+
+@implementation ACCachePackTests
+
+- (void)setUp {
+    [super setUp];
+    _path = [NSTemporaryDirectory() stringByAppendingPathComponent:[NSString stringWithFormat:@"pack.%@", [NSUUID UUID].UUIDString]];
+}
+
+- (void)tearDown {
+    [[NSFileManager defaultManager] removeItemAtPath:_path error:nil];
+    [super tearDown];
+}
+
+- (ACSimulatedObject *)objectWithID:(NSString *)objectID version:(NSString *)version {
+    return [[ACSimulatedObject alloc] initWithObjectID:objectID version:version payload:[objectID dataUsingEncoding:NSUTF8StringEncoding]];
+}
+
+- (ACCachePack *)packWithCount:(NSUInteger)count {
+    ACCachePackWriter *writer = [ACCachePackWriter new];
+    for (NSUInteger i = 0; i < count; i++) {
+        [writer addObject:[self objectWithID:[NSString stringWithFormat:@"tile.%lu", (unsigned long)i] version:@"1"]];
+    }
+
+    NSError *error = nil;
+    XCTAssertTrue([writer writeToFile:_path error:&error], @"%@", error);
+    return [ACCachePack packWithContentsOfFile:_path error:&error];
+}
+
+- (void)testRoundTrip {
+    ACCachePack *pack = [self packWithCount:300];
+    XCTAssertEqual(pack.count, 300);
+
+    ACSimulatedObject *object = (ACSimulatedObject *)[pack objectForKey:@"tile.42"];
+    XCTAssertEqualObjects(object.objectID, @"tile.42");
+    XCTAssertEqualObjects(object.payload, [@"tile.42" dataUsingEncoding:NSUTF8StringEncoding]);
+    XCTAssertEqualObjects([pack versionForKey:@"tile.299"], @"1");
+    XCTAssertNil([pack dataForKey:@"tile.300"]);
+    XCTAssertFalse([pack containsKey:@"tile"]);
+
+    __block NSUInteger enumerated = 0;
+    [pack enumerateKeysAndVersionsUsingBlock:^(NSString *key, NSString *version, BOOL *stop) {
+        enumerated++;
+    }];
+    XCTAssertEqual(enumerated, 300);
+}
+
+- (void)testLaterEntryReplacesEarlier {
+    ACCachePackWriter *writer = [ACCachePackWriter new];
+    [writer addObject:[self objectWithID:@"floor.1" version:@"1"]];
+    [writer addObject:[self objectWithID:@"floor.1" version:@"2"]];
+    XCTAssertEqual(writer.count, 1);
+    XCTAssertTrue([writer writeToFile:_path error:nil]);
+
+    XCTAssertEqualObjects([[ACCachePack packWithContentsOfFile:_path error:nil] versionForKey:@"floor.1"], @"2");
+}
+
+- (void)testMalformedFileIsRejected {
+    [[@"not a pack" dataUsingEncoding:NSUTF8StringEncoding] writeToFile:_path atomically:YES];
+
+    NSError *error = nil;
+    XCTAssertNil([ACCachePack packWithContentsOfFile:_path error:&error]);
+    XCTAssertEqualObjects(error.domain, ACCachePackErrorDomain);
+    XCTAssertEqual(error.code, ACCachePackErrorInvalidFormat);
+}
+
+- (void)testFullBucketTableIsRejected {
+    [self packWithCount:3];
+    NSMutableData *data = [NSMutableData dataWithContentsOfFile:_path];
+    ACCachePackHeader *header = data.mutableBytes;
+    uint32_t *buckets = (uint32_t *)(header + 1);
+    for (uint32_t i = 0; i < header->bucketCount; i++) {
+        buckets[i] = 1;
+    }
+    [data writeToFile:_path atomically:YES];
+
+    NSError *error = nil;
+    XCTAssertNil([ACCachePack packWithContentsOfFile:_path error:&error]);
+    XCTAssertEqual(error.code, ACCachePackErrorInvalidFormat);
+}
+
+- (void)testCacheOverlaysPack {
+    ACCachePack *pack = [self packWithCount:10];
+    ACCache *cache = [[ACCache alloc] initWithName:@"pack.overlay" filePath:[_path stringByAppendingString:@".cache"]];
+    [cache removeAllObjects];
+    [cache attachPack:pack];
+
+    XCTAssertTrue([cache containsObjectForKey:@"tile.3"]);
+    XCTAssertEqualObjects([(ACSimulatedObject *)[cache objectForKey:@"tile.3"] objectVersion], @"1");
+
+    [cache setObject:[self objectWithID:@"tile.3" version:@"2"] forKey:@"tile.3"];
+    [cache.memoryCache removeAllObjects];
+    XCTAssertEqualObjects([(ACSimulatedObject *)[cache objectForKey:@"tile.3"] objectVersion], @"2");
+
+    // removed overlay does not bring stale pack version back
+    [cache removeObjectForKey:@"tile.3"];
+    XCTAssertFalse([cache containsObjectForKey:@"tile.3"]);
+    XCTAssertNil([cache objectForKey:@"tile.3"]);
+    [cache setObject:[self objectWithID:@"tile.3" version:@"3"] forKey:@"tile.3"];
+    XCTAssertEqualObjects([(ACSimulatedObject *)[cache objectForKey:@"tile.3"] objectVersion], @"3");
+
+    // only keys overlaid on disk are hidden by removing everything, the rest of the pack stays
+    [cache setObject:[self objectWithID:@"tile.5" version:@"2"] forKey:@"tile.5"];
+    [cache removeAllObjects];
+    XCTAssertFalse([cache containsObjectForKey:@"tile.3"]);
+    XCTAssertFalse([cache containsObjectForKey:@"tile.5"]);
+    XCTAssertTrue([cache containsObjectForKey:@"tile.4"]);
+
+    [cache detachPack:pack];
+    XCTAssertFalse([cache containsObjectForKey:@"tile.4"]);
+    [cache removeAllObjects];
+    [[NSFileManager defaultManager] removeItemAtPath:[_path stringByAppendingString:@".cache"] error:nil];
+}
+
+- (void)testWriterPacksDiskObjectsOnly {
+    ACCache *cache = [[ACCache alloc] initWithName:@"pack.writer" filePath:[_path stringByAppendingString:@".cache"]];
+    [cache attachPack:[self packWithCount:10]];
+    [cache setObject:[self objectWithID:@"tile.3" version:@"2"] forKey:@"tile.3"];
+    [cache setObject:[self objectWithID:@"floor.1" version:@"1"] forKey:@"floor.1"];
+
+    ACCachePackWriter *writer = [ACCachePackWriter new];
+    XCTAssertEqual([writer addObjectsForKeys:@[@"tile.3", @"tile.4", @"floor.1"] fromCache:cache], 2);
+    XCTAssertEqual(writer.count, 2);
+    // pack objects are not pulled into memory cache
+    XCTAssertFalse([cache.memoryCache containsObjectForKey:@"tile.4"]);
+
+    [cache removeAllObjects];
+    [[NSFileManager defaultManager] removeItemAtPath:[_path stringByAppendingString:@".cache"] error:nil];
+}
+
+- (void)testCheckoutAfterAttachDownloadsChangedKeysOnly {
+    // refresh timer only runs while reachable
+    if ([[Reachability reachabilityForInternetConnection] currentReachabilityStatus] == NotReachable) return;
+
+    ACSimulatedDownloader *downloader = [ACSimulatedDownloader new];
+    downloader.medianLatency = 0.01;
+    [downloader setVersion:2 forKey:@"tile.2"];
+    [downloader setVersion:2 forKey:@"tile.5"];
+    ACCacheManager *manager = [[ACCacheManager alloc] initWithName:[NSString stringWithFormat:@"pack.%@", [NSUUID UUID].UUIDString] downloader:downloader cacheToDisk:NO refreshInterval:0.2];
+    [manager attachPack:[self packWithCount:10]];
+
+    NSDate *deadline = [NSDate dateWithTimeIntervalSinceNow:5];
+    while (downloader.checkoutCount < 3 && [deadline timeIntervalSinceNow] > 0) {
+        [NSThread sleepForTimeInterval:0.05];
+    }
+
+    XCTAssertGreaterThanOrEqual(downloader.checkoutCount, 3);
+    XCTAssertEqual(downloader.downloadedKeyCount, 2);
+    XCTAssertEqualObjects([manager objectForKey:@"tile.5"].objectVersion, @"2");
+    XCTAssertEqualObjects([manager objectForKey:@"tile.4"].objectVersion, @"1");
+    [manager.storage removeAllObjects];
+}
+
+- (void)testManagerServesPackWithoutDownloading {
+    ACSimulatedDownloader *downloader = [ACSimulatedDownloader new];
+    ACCacheManager *manager = [[ACCacheManager alloc] initWithName:[NSString stringWithFormat:@"pack.%@", [NSUUID UUID].UUIDString] downloader:downloader cacheToDisk:NO refreshInterval:3600];
+    [manager attachPack:[self packWithCount:10]];
+
+    __block id <ACCacheObject> result = nil;
+    [manager objectForKey:@"tile.7" completionHandler:^(NSError *error, id<ACCacheObject> cache) {
+        result = cache;
+    }];
+
+    XCTAssertEqualObjects(result.objectID, @"tile.7");
+    XCTAssertEqual(downloader.requestCount, 0);
+    [manager.storage removeAllObjects];
+}
+
+@end
@@ -0,0 +1,52 @@
+//
+//  ACHexColorTests.m
+//  ACSnippet_Tests
+//
+//  Created by Wenzhi WU on 19/10/2026.
+//  Copyright © 2026 Wenzhi WU. All rights reserved.
+//
+
+@import XCTest;
+#import <ACSnippet/NSString+HexColor.h>
+
+@interface ACHexColorTests : XCTestCase
+
+@end
+
+@implementation ACHexColorTests
+
+- (void)assertColor:(UIColor *)color red:(CGFloat)red green:(CGFloat)green blue:(CGFloat)blue alpha:(CGFloat)alpha {
+    CGFloat r, g, b, a;
+    XCTAssertTrue([color getRed:&r green:&g blue:&b alpha:&a]);
+    XCTAssertEqualWithAccuracy(r, red, 0.001);
+    XCTAssertEqualWithAccuracy(g, green, 0.001);
+    XCTAssertEqualWithAccuracy(b, blue, 0.001);
+    XCTAssertEqualWithAccuracy(a, alpha, 0.001);
+}
+
+- (void)testSupportedForms {
+    [self assertColor:[@"#F80" hexColor] red:1.0 green:0x88 / 255.0 blue:0.0 alpha:1.0];
+    [self assertColor:[@"#8F80" hexColor] red:1.0 green:0x88 / 255.0 blue:0.0 alpha:0x88 / 255.0];
+    [self assertColor:[@"#ff8000" hexColor] red:1.0 green:0x80 / 255.0 blue:0.0 alpha:1.0];
+    [self assertColor:[@"80FF8000" hexColor] red:1.0 green:0x80 / 255.0 blue:0.0 alpha:0x80 / 255.0];
+}
+
+- (void)testRepeatedStringsShareColor {
+    NSString *first = [NSString stringWithFormat:@"#%@", @"12AB34"];
+    NSString *second = [NSString stringWithFormat:@"#%@", @"12ab34"];
+    XCTAssertEqual([first hexColor], [second hexColor]);
+}
+
+- (void)testInvalidInputReportsError {
+    NSError *error = nil;
+    XCTAssertNil([@"#12345" hexColorWithError:&error]);
+    XCTAssertEqualObjects(error.domain, ACHexColorErrorDomain);
+    XCTAssertEqual(error.code, ACHexColorErrorInvalidLength);
+
+    XCTAssertNil([@"#GG0000" hexColorWithError:&error]);
+    XCTAssertEqual(error.code, ACHexColorErrorInvalidCharacter);
+
+    XCTAssertThrows([@"#12345" hexColor]);
+}
+
+@end
@@ -0,0 +1,84 @@
+//
+//  ACSimulatedDownloader.h
+//  ACSnippet_Tests
+//
+//  Created by Wenzhi WU on 19/10/2026.
+//  Copyright © 2026 Wenzhi WU. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import <ACSnippet/ACCacheManagerDownloader.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// Cache object served by ACSimulatedDownloader
+@interface ACSimulatedObject : NSObject <ACCacheObject>
+
+/// Object ID
+@property (nonatomic, copy, readonly) NSString  *objectID;
+
+/// Object version
+@property (nonatomic, copy, readonly) NSString  *objectVersion;
+
+/// Payload bytes
+@property (nonatomic, copy, readonly) NSData    *payload;
+
+/// Designate initializer for ACSimulatedObject object
+/// @param objectID Object ID
+/// @param version Object version
+/// @param payload Payload bytes
+- (instancetype)initWithObjectID:(NSString *)objectID version:(NSString *)version payload:(NSData *)payload;
+
+@end
+
+/// In-process downloader with configurable latency, failures, batch limit and version churn, for load testing ACCacheManager
+@interface ACSimulatedDownloader : NSObject <ACCacheManagerDownloader>
+
+/// Median latency of one request in seconds, default is 0.05
+@property (nonatomic, assign) NSTimeInterval medianLatency;
+
+/// Spread of log-normal latency distribution, 0 for constant latency, default is 0.5
+@property (nonatomic, assign) double latencySpread;
+
+/// Probability that a request fails, default is 0
+@property (nonatomic, assign) double failureRate;
+
+/// Maximum keys served per request, larger requests are served in sequential batches, default is 50
+@property (nonatomic, assign) NSUInteger maximumBatchSize;
+
+/// Probability that version of a key changes at each checkout, default is 0
+@property (nonatomic, assign) double versionChurnRate;
+
+/// Payload bytes of each object, default is 1024
+@property (nonatomic, assign) NSUInteger payloadSize;
+
+/// Number of download requests
+@property (nonatomic, assign, readonly) NSUInteger requestCount;
+
+/// Number of keys served, including duplicates
+@property (nonatomic, assign, readonly) NSUInteger downloadedKeyCount;
+
+/// Number of keys requested while the same key was still in downloading
+@property (nonatomic, assign, readonly) NSUInteger duplicateDownloadCount;
+
+/// Number of failed requests
+@property (nonatomic, assign, readonly) NSUInteger failureCount;
+
+/// Number of version checkouts
+@property (nonatomic, assign, readonly) NSUInteger checkoutCount;
+
+/// Designate initializer for ACSimulatedDownloader object
+/// @param seed Random seed, runs with the same seed and settings draw the same latencies
+- (instancetype)initWithSeed:(uint32_t)seed;
+
+/// Reset counters
+- (void)resetStatistics;
+
+/// Set version served for key from now on
+/// @param version Version number, versions start at 1
+/// @param key Key for object
+- (void)setVersion:(NSUInteger)version forKey:(NSString *)key;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,213 @@
+//
+//  ACSimulatedDownloader.m
+//  ACSnippet_Tests
+//
+//  Created by Wenzhi WU on 19/10/2026.
+//  Copyright © 2026 Wenzhi WU. All rights reserved.
+//
+
+#import "ACSimulatedDownloader.h"
+#import <pthread.h>
+
+#pragma mark - ACSimulatedObject
+
+@implementation ACSimulatedObject
+
+- (instancetype)initWithObjectID:(NSString *)objectID version:(NSString *)version payload:(NSData *)payload {
+    self = [super init];
+    if (self) {
+        _objectID = objectID.copy;
+        _objectVersion = version.copy;
+        _payload = payload;
+    }
+
+    return self;
+}
+
+- (instancetype)initWithCoder:(NSCoder *)coder {
+    return [self initWithObjectID:[coder decodeObjectForKey:@"id"]
+                          version:[coder decodeObjectForKey:@"version"]
+                          payload:[coder decodeObjectForKey:@"payload"]];
+}
+
+- (void)encodeWithCoder:(NSCoder *)coder {
+    [coder encodeObject:_objectID forKey:@"id"];
+    [coder encodeObject:_objectVersion forKey:@"version"];
+    [coder encodeObject:_payload forKey:@"payload"];
+}
+
+@end
+
+#pragma mark - ACSimulatedDownloader
+
+@interface ACSimulatedDownloader ()
+
+/// Lock for thread safe
+@property (nonatomic, assign) pthread_mutex_t lock;
+
+/// Random state
+@property (nonatomic, assign) uint32_t state;
+
+/// Number of in-flight downloads per key
+@property (nonatomic, strong) NSCountedSet <NSString *> *downloading;
+
+/// Current version per key, keys without entry are at version 1
+@property (nonatomic, strong) NSMutableDictionary <NSString *, NSNumber *> *versions;
+
+/// Shared payload
+@property (nonatomic, strong) NSData *payload;
+
+@end
+
+@implementation ACSimulatedDownloader
+
+- (instancetype)init {
+    return [self initWithSeed:1];
+}
+
+- (instancetype)initWithSeed:(uint32_t)seed {
+    self = [super init];
+    if (self) {
+        pthread_mutex_init(&_lock, NULL);
+        _state = seed ?: 1;
+        _medianLatency = 0.05;
+        _latencySpread = 0.5;
+        _maximumBatchSize = 50;
+        _payloadSize = 1024;
+        _downloading = [NSCountedSet set];
+        _versions = @{}.mutableCopy;
+    }
+
+    return self;
+}
+
+- (void)dealloc {
+    pthread_mutex_destroy(&_lock);
+}
+
+- (void)resetStatistics {
+    pthread_mutex_lock(&_lock);
+    _requestCount = 0;
+    _downloadedKeyCount = 0;
+    _duplicateDownloadCount = 0;
+    _failureCount = 0;
+    _checkoutCount = 0;
+    pthread_mutex_unlock(&_lock);
+}
+
+- (void)setVersion:(NSUInteger)version forKey:(NSString *)key {
+    pthread_mutex_lock(&_lock);
+    _versions[key] = @(version);
+    pthread_mutex_unlock(&_lock);
+}
+
+#pragma mark - ACCacheManagerDownloader
+- (NSArray *)filterOutKeysInDownloading:(NSArray<NSString *> *)keys {
+    NSMutableArray *filtered = [NSMutableArray arrayWithCapacity:keys.count];
+    pthread_mutex_lock(&_lock);
+    for (NSString *key in keys) {
+        if ([_downloading countForObject:key] == 0) [filtered addObject:key];
+    }
+    pthread_mutex_unlock(&_lock);
+    return filtered.copy;
+}
+
+- (NSArray *)keysInDownloading {
+    pthread_mutex_lock(&_lock);
+    NSArray *keys = _downloading.allObjects;
+    pthread_mutex_unlock(&_lock);
+    return keys;
+}
+
+- (void)checkoutObjectVesionsForKeys:(NSArray *)keys completionHandler:(void (^)(NSError *, NSDictionary *, NSArray<NSString *> *))handler {
+    NSMutableDictionary *versions = [NSMutableDictionary dictionaryWithCapacity:[keys count]];
+    pthread_mutex_lock(&_lock);
+    _checkoutCount++;
+    for (NSString *key in keys) {
+        NSUInteger version = MAX(1, [_versions[key] unsignedIntegerValue]);
+        if ([self randomUnit] < _versionChurnRate) {
+            version++;
+            _versions[key] = @(version);
+        }
+        versions[key] = [NSString stringWithFormat:@"%lu", (unsigned long)version];
+    }
+    NSTimeInterval latency = [self nextLatency];
+    pthread_mutex_unlock(&_lock);
+
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(latency * NSEC_PER_SEC)), dispatch_get_global_queue(0, 0), ^{
+        handler(nil, versions.copy, keys);
+    });
+}
+
+- (void)downloadObjectsForKeys:(NSArray *)keys completionHandler:(void (^)(NSError *, NSArray<id<ACCacheObject>> *))handler {
+    NSArray *requested = [keys copy];
+    pthread_mutex_lock(&_lock);
+    _requestCount++;
+    for (NSString *key in requested) {
+        if ([_downloading countForObject:key] > 0) _duplicateDownloadCount++;
+        [_downloading addObject:key];
+    }
+    if (!_payload || _payload.length != _payloadSize) {
+        NSMutableData *payload = [NSMutableData dataWithLength:_payloadSize];
+        arc4random_buf(payload.mutableBytes, payload.length);
+        _payload = payload.copy;
+    }
+
+    // batches are served one after another, so a large request waits for every batch
+    NSUInteger batchSize = MAX(1, _maximumBatchSize);
+    NSUInteger batches = MAX(1, (requested.count + batchSize - 1) / batchSize);
+    NSTimeInterval latency = 0;
+    for (NSUInteger i = 0; i < batches; i++) {
+        latency += [self nextLatency];
+    }
+    BOOL fail = [self randomUnit] < _failureRate;
+    pthread_mutex_unlock(&_lock);
+
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(latency * NSEC_PER_SEC)), dispatch_get_global_queue(0, 0), ^{
+        NSMutableArray *objects = nil;
+        pthread_mutex_lock(&self->_lock);
+        for (NSString *key in requested) {
+            [self.downloading removeObject:key];
+        }
+        if (fail) {
+            self->_failureCount++;
+        } else {
+            objects = [NSMutableArray arrayWithCapacity:requested.count];
+            for (NSString *key in requested) {
+                NSUInteger version = MAX(1, [self.versions[key] unsignedIntegerValue]);
+                [objects addObject:[[ACSimulatedObject alloc] initWithObjectID:key version:[NSString stringWithFormat:@"%lu", (unsigned long)version] payload:self.payload]];
+            }
+            self->_downloadedKeyCount += requested.count;
+        }
+        pthread_mutex_unlock(&self->_lock);
+
+        if (fail) {
+            handler([NSError errorWithDomain:@"ACSimulatedDownloader" code:-1 userInfo:@{NSLocalizedDescriptionKey: @"Simulated failure"}], nil);
+        } else {
+            handler(nil, objects.copy);
+        }
+    });
+}
+
+#pragma mark - Random
+/// Uniform value in [0, 1), lock should be held
+- (double)randomUnit {
+    uint32_t x = _state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    _state = x;
+    return (double)x / 4294967296.0;
+}
+
+/// Log-normal latency around median, lock should be held
+- (NSTimeInterval)nextLatency {
+    if (_latencySpread <= 0) return _medianLatency;
+
+    double u1 = MAX([self randomUnit], 1e-12);
+    double u2 = [self randomUnit];
+    double z = sqrt(-2.0 * log(u1)) * cos(2.0 * M_PI * u2);
+    return _medianLatency * exp(_latencySpread * z);
+}
+
+@end
@@ -0,0 +1,251 @@
+//
+//  ACStyleLayerManagerTests.m
+//  ACSnippet_Tests
+//
+//  Created by Wenzhi WU on 19/10/2026.
+//  Copyright © 2026 Wenzhi WU. All rights reserved.
+//
+
+@import XCTest;
+#import <ACSnippet/ACStyleLayerManager.h>
+
+/// Style stand-in that keeps layers bottom to top and counts mutations
+@interface ACMockStyle : NSObject <ACStyleLayerManagerStyle>
+@property (nonatomic, strong) NSMutableArray <MGLStyleLayer *> *layers;
+@property (nonatomic, strong) NSMutableArray <MGLSource *> *sources;
+@property (nonatomic, assign) NSUInteger lookupCount;
+@property (nonatomic, assign) NSUInteger insertCount;
+@property (nonatomic, assign) NSUInteger removeCount;
+@end
+
+@implementation ACMockStyle
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _layers = @[].mutableCopy;
+        _sources = @[].mutableCopy;
+    }
+
+    return self;
+}
+
+- (MGLStyleLayer *)layerWithIdentifier:(NSString *)identifier {
+    _lookupCount++;
+    for (MGLStyleLayer *layer in _layers) {
+        if ([layer.identifier isEqualToString:identifier]) return layer;
+    }
+
+    return nil;
+}
+
+- (void)insertLayer:(MGLStyleLayer *)layer aboveLayer:(MGLStyleLayer *)sibling {
+    _insertCount++;
+    [_layers insertObject:layer atIndex:[_layers indexOfObject:sibling] + 1];
+}
+
+- (void)removeLayer:(MGLStyleLayer *)layer {
+    _removeCount++;
+    [_layers removeObject:layer];
+}
+
+- (void)addSource:(MGLSource *)source {
+    // MGLStyle rejects a second source with the same identifier
+    if ([self sourceWithIdentifier:source.identifier]) {
+        [NSException raise:@"MGLRedundantSourceIdentifierException" format:@"Source %@ already exists", source.identifier];
+    }
+    [_sources addObject:source];
+}
+
+- (void)removeSource:(MGLSource *)source {
+    [_sources removeObject:source];
+}
+
+- (MGLSource *)sourceWithIdentifier:(NSString *)identifier {
+    for (MGLSource *source in _sources) {
+        if ([source.identifier isEqualToString:identifier]) return source;
+    }
+
+    return nil;
+}
+
+- (NSArray <NSString *>*)layerIdentifiers {
+    return [_layers valueForKey:@"identifier"];
+}
+
+@end
+
+@interface ACStyleLayerManagerTests : XCTestCase
+@property (nonatomic, strong) ACMockStyle *style;
+@property (nonatomic, strong) ACStyleLayerManager *manager;
+@end
+
+@implementation ACStyleLayerManagerTests
+
+- (void)setUp {
+    [super setUp];
+    _style = [ACMockStyle new];
+    MGLStyleLayer *base = [self layerWithIdentifier:@"base"];
+    [_style.layers addObject:base];
+    _manager = [ACStyleLayerManager new];
+    [_manager addToStyle:_style withBaseLayer:base];
+}
+
+- (MGLStyleLayer *)layerWithIdentifier:(NSString *)identifier {
+    return [[MGLBackgroundStyleLayer alloc] initWithIdentifier:identifier];
+}
+
+- (void)testAddOutsideTransactionKeepsTypeOrder {
+    [_manager addKey:@"poi" withStyleLayers:@[[self layerWithIdentifier:@"poi"]] ofType:ACStyleLayerTypeBuildingFloorPlanPOILayer];
+    [_manager addKey:@"floor" withStyleLayers:@[[self layerWithIdentifier:@"floor"]] ofType:ACStyleLayerTypeBuildingFloorPlanBaseLayer];
+    [_manager addKey:@"line" withStyleLayers:@[[self layerWithIdentifier:@"line"]] ofType:ACStyleLayerTypeBuildingFloorPlanLineLayer];
+
+    XCTAssertEqualObjects([_style layerIdentifiers], (@[@"base", @"floor", @"line", @"poi"]));
+}
+
+- (void)testTransactionDropsCancelledAdditions {
+    [_manager beginUpdates];
+    [_manager addKey:@"1F" withStyleLayers:@[[self layerWithIdentifier:@"1F.fill"], [self layerWithIdentifier:@"1F.line"]] ofType:ACStyleLayerTypeBuildingFloorPlanBaseLayer];
+    [_manager addKey:@"2F" withStyleLayers:@[[self layerWithIdentifier:@"2F.fill"], [self layerWithIdentifier:@"2F.line"]] ofType:ACStyleLayerTypeBuildingFloorPlanBaseLayer];
+    [_manager addKey:@"2F.poi" withStyleLayers:@[[self layerWithIdentifier:@"2F.poi"]] ofType:ACStyleLayerTypeBuildingFloorPlanPOILayer];
+    [_manager removeKey:@"1F" ofType:ACStyleLayerTypeBuildingFloorPlanBaseLayer];
+    XCTAssertEqual(_style.insertCount, 0);
+    [_manager commitUpdates];
+
+    XCTAssertEqualObjects([_style layerIdentifiers], (@[@"base", @"2F.fill", @"2F.line", @"2F.poi"]));
+    XCTAssertEqual(_style.insertCount, 3);
+    XCTAssertEqual(_style.removeCount, 0);
+    // one anchor lookup per type
+    XCTAssertEqual(_style.lookupCount, 2);
+}
+
+- (void)testTransactionSwitchesFloor {
+    [_manager addKey:@"1F" withStyleLayers:@[[self layerWithIdentifier:@"1F"]] ofType:ACStyleLayerTypeBuildingFloorPlanBaseLayer];
+    [_manager addKey:@"1F.poi" withStyleLayers:@[[self layerWithIdentifier:@"1F.poi"]] ofType:ACStyleLayerTypeBuildingFloorPlanPOILayer];
+
+    [_manager beginUpdates];
+    [_manager removeKey:@"1F.poi" ofType:ACStyleLayerTypeBuildingFloorPlanPOILayer];
+    [_manager removeKey:@"1F" ofType:ACStyleLayerTypeBuildingFloorPlanBaseLayer];
+    [_manager addKey:@"2F.poi" withStyleLayers:@[[self layerWithIdentifier:@"2F.poi"]] ofType:ACStyleLayerTypeBuildingFloorPlanPOILayer];
+    [_manager addKey:@"2F" withStyleLayers:@[[self layerWithIdentifier:@"2F"]] ofType:ACStyleLayerTypeBuildingFloorPlanBaseLayer];
+    [_manager commitUpdates];
+
+    XCTAssertEqualObjects([_style layerIdentifiers], (@[@"base", @"2F", @"2F.poi"]));
+}
+
+- (void)testReaddingKeyReplacesLayers {
+    [_manager addKey:@"1F" withStyleLayers:@[[self layerWithIdentifier:@"1F.old"]] ofType:ACStyleLayerTypeBuildingFloorPlanBaseLayer];
+    [_manager addKey:@"1F" withStyleLayers:@[[self layerWithIdentifier:@"1F.new"]] ofType:ACStyleLayerTypeBuildingFloorPlanBaseLayer];
+
+    XCTAssertEqualObjects([_style layerIdentifiers], (@[@"base", @"1F.new"]));
+}
+
+- (void)testReaddingSourceReplacesStyleSourceWithSameIdentifier {
+    MGLSource *old = [[MGLShapeSource alloc] initWithIdentifier:@"1F" shape:nil options:nil];
+    MGLSource *new = [[MGLShapeSource alloc] initWithIdentifier:@"1F" shape:nil options:nil];
+    [_manager addSource:old withStyleLayers:@[[self layerWithIdentifier:@"1F.old"]] ofType:ACStyleLayerTypeBuildingFloorPlanBaseLayer];
+    XCTAssertNoThrow([_manager addSource:new withStyleLayers:@[[self layerWithIdentifier:@"1F.new"]] ofType:ACStyleLayerTypeBuildingFloorPlanBaseLayer]);
+
+    XCTAssertEqualObjects(_style.sources, @[new]);
+    XCTAssertEqualObjects([_style layerIdentifiers], (@[@"base", @"1F.new"]));
+
+    [_manager removeSource:[[MGLShapeSource alloc] initWithIdentifier:@"1F" shape:nil options:nil] ofType:ACStyleLayerTypeBuildingFloorPlanBaseLayer];
+    XCTAssertEqual(_style.sources.count, 0);
+    XCTAssertEqualObjects([_style layerIdentifiers], @[@"base"]);
+}
+
+#pragma mark - Reconcile
+- (NSArray <ACStyleLayerGroup *>*)groupsWithFloor:(NSString *)floor rooms:(NSArray <NSString *>*)rooms {
+    NSMutableArray *groups = @[].mutableCopy;
+    [groups addObject:[ACStyleLayerGroup groupWithType:ACStyleLayerTypeBuildingFloorPlanBaseLayer key:floor layers:@[[self layerWithIdentifier:floor]]]];
+    for (NSString *room in rooms) {
+        NSString *identifier = [NSString stringWithFormat:@"%@.%@", floor, room];
+        [groups addObject:[ACStyleLayerGroup groupWithType:ACStyleLayerTypeBuildingFloorPlanPOILayer key:identifier layers:@[[self layerWithIdentifier:identifier]]]];
+    }
+
+    return groups.copy;
+}
+
+- (void)testReconcileWithoutChangesIssuesNoStyleOperations {
+    [_manager reconcileWithLayerGroups:[self groupsWithFloor:@"1F" rooms:@[@"a", @"b", @"c"]]];
+    XCTAssertEqualObjects([_style layerIdentifiers], (@[@"base", @"1F", @"1F.a", @"1F.b", @"1F.c"]));
+
+    NSUInteger inserts = _style.insertCount, removes = _style.removeCount, lookups = _style.lookupCount;
+    [_manager reconcileWithLayerGroups:[self groupsWithFloor:@"1F" rooms:@[@"a", @"b", @"c"]]];
+    XCTAssertEqual(_style.insertCount, inserts);
+    XCTAssertEqual(_style.removeCount, removes);
+    XCTAssertEqual(_style.lookupCount, lookups);
+}
+
+- (void)testReconcileKeepsUnchangedPrefix {
+    [_manager reconcileWithLayerGroups:[self groupsWithFloor:@"1F" rooms:@[@"a", @"b", @"c"]]];
+    NSUInteger inserts = _style.insertCount, removes = _style.removeCount;
+
+    // c is dropped and d appended, a and b stay in place
+    [_manager reconcileWithLayerGroups:[self groupsWithFloor:@"1F" rooms:@[@"a", @"b", @"d"]]];
+    XCTAssertEqualObjects([_style layerIdentifiers], (@[@"base", @"1F", @"1F.a", @"1F.b", @"1F.d"]));
+    XCTAssertEqual(_style.insertCount - inserts, 1);
+    XCTAssertEqual(_style.removeCount - removes, 1);
+}
+
+- (void)testReconcileInsertsInMiddleAndMovesOnlyChangedGroups {
+    [_manager reconcileWithLayerGroups:[self groupsWithFloor:@"1F" rooms:@[@"a", @"b", @"c"]]];
+    NSUInteger inserts = _style.insertCount, removes = _style.removeCount;
+
+    // x goes right above a, layers above it stay in place
+    [_manager reconcileWithLayerGroups:[self groupsWithFloor:@"1F" rooms:@[@"a", @"x", @"b", @"c"]]];
+    XCTAssertEqualObjects([_style layerIdentifiers], (@[@"base", @"1F", @"1F.a", @"1F.x", @"1F.b", @"1F.c"]));
+    XCTAssertEqual(_style.insertCount - inserts, 1);
+    XCTAssertEqual(_style.removeCount - removes, 0);
+
+    // c moves to the bottom of its type, the rest is the common subsequence
+    inserts = _style.insertCount;
+    [_manager reconcileWithLayerGroups:[self groupsWithFloor:@"1F" rooms:@[@"c", @"a", @"x", @"b"]]];
+    XCTAssertEqualObjects([_style layerIdentifiers], (@[@"base", @"1F", @"1F.c", @"1F.a", @"1F.x", @"1F.b"]));
+    XCTAssertEqual(_style.insertCount - inserts, 1);
+    XCTAssertEqual(_style.removeCount - removes, 1);
+
+    // counter keeps the reconciled order, so a plain addition still goes on top
+    [_manager addKey:@"1F.z" withStyleLayers:@[[self layerWithIdentifier:@"1F.z"]] ofType:ACStyleLayerTypeBuildingFloorPlanPOILayer];
+    XCTAssertEqualObjects([_style layerIdentifiers].lastObject, @"1F.z");
+}
+
+- (void)testReconcileAddsOnTopWhenAnchorLayerIsGone {
+    [_manager reconcileWithLayerGroups:[self groupsWithFloor:@"1F" rooms:@[@"a", @"b", @"c"]]];
+    // anchor of x is removed behind the manager's back
+    [_style.layers removeObject:[_style layerWithIdentifier:@"1F.a"]];
+
+    [_manager reconcileWithLayerGroups:[self groupsWithFloor:@"1F" rooms:@[@"a", @"x", @"b", @"c"]]];
+    XCTAssertEqualObjects([_style layerIdentifiers], (@[@"base", @"1F", @"1F.b", @"1F.c", @"1F.x"]));
+
+    // counter follows the style order, a plain addition goes above x
+    [_manager addKey:@"1F.z" withStyleLayers:@[[self layerWithIdentifier:@"1F.z"]] ofType:ACStyleLayerTypeBuildingFloorPlanPOILayer];
+    XCTAssertEqualObjects([_style layerIdentifiers], (@[@"base", @"1F", @"1F.b", @"1F.c", @"1F.x", @"1F.z"]));
+}
+
+- (void)testReconcileEmptiesMissingTypes {
+    [_manager reconcileWithLayerGroups:[self groupsWithFloor:@"1F" rooms:@[@"a"]]];
+    [_manager reconcileWithLayerGroups:@[[ACStyleLayerGroup groupWithType:ACStyleLayerTypeBuildingFloorPlanBaseLayer key:@"2F" layers:@[[self layerWithIdentifier:@"2F"]]]]];
+
+    XCTAssertEqualObjects([_style layerIdentifiers], (@[@"base", @"2F"]));
+}
+
+#pragma mark - Type order
+- (void)testRegisteredTypesKeepOrderAcrossRelabeling {
+    // each type goes right above the base, squeezing the same label gap until it is relabeled
+    for (NSUInteger i = 0; i < 80; i++) {
+        NSString *type = [NSString stringWithFormat:@"custom.%lu", (unsigned long)i];
+        [_manager registerLayerType:type aboveLayerType:ACStyleLayerTypeMapViewBaseLayer];
+        if (i % 20 == 0) {
+            [_manager addKey:type withStyleLayers:@[[self layerWithIdentifier:type]] ofType:type];
+        }
+    }
+
+    [_manager addKey:@"floor" withStyleLayers:@[[self layerWithIdentifier:@"floor"]] ofType:ACStyleLayerTypeBuildingFloorPlanBaseLayer];
+    [_manager removeKey:@"custom.40" ofType:@"custom.40"];
+    [_manager addKey:@"custom.50" withStyleLayers:@[[self layerWithIdentifier:@"custom.50"]] ofType:@"custom.50"];
+
+    XCTAssertEqualObjects([_style layerIdentifiers], (@[@"base", @"custom.60", @"custom.50", @"custom.20", @"custom.0", @"floor"]));
+}
+
+@end
@@ -0,0 +1,122 @@
+//
+//  ACTileCoverageTests.m
+//  ACSnippet_Tests
+//
+//  Created by Wenzhi WU on 19/10/2026.
+//  Copyright © 2026 Wenzhi WU. All rights reserved.
+//
+
+@import XCTest;
+#import <ACSnippet/ACTileManager.h>
+
+@interface ACTileCoverageTests : XCTestCase
+@property (nonatomic, strong) ACTileManager *manager;
+@end
+
+@implementation ACTileCoverageTests
+
+- (void)setUp {
+    [super setUp];
+    _manager = [[ACTileManager alloc] initWithHightDPITileImages:NO];
+}
+
+/// Coordinate at fractional tile x/y under Google schema
+- (CLLocationCoordinate2D)coordinateAtTileX:(double)x y:(double)y zoom:(NSUInteger)zoom {
+    double size = (double)(1ULL << zoom);
+    double latitude = atan(sinh(M_PI * (1 - 2 * y / size))) * 180.0 / M_PI;
+    return CLLocationCoordinate2DMake(latitude, x / size * 360.0 - 180.0);
+}
+
+/// Tile codes of x/y pairs at zoom level
+- (NSSet <NSString *>*)tileCodesWithZoom:(NSUInteger)zoom pairs:(const NSUInteger *)pairs count:(NSUInteger)count {
+    NSMutableSet *codes = [NSMutableSet set];
+    for (NSUInteger i = 0; i < count; i++) {
+        [codes addObject:[_manager tileCodeWithZoom:zoom x:pairs[i * 2] y:pairs[i * 2 + 1]]];
+    }
+
+    return codes.copy;
+}
+
+- (void)testSegmentTraversalVisitsCrossedTiles {
+    // slope 1/2 crosses x = 1, then y = 1, then x = 2
+    CLLocationCoordinate2D line[] = {
+        [self coordinateAtTileX:0.5 y:0.5 zoom:3],
+        [self coordinateAtTileX:2.5 y:1.5 zoom:3],
+    };
+    NSArray *codes = [_manager tileCodesWithZoom:3 coveringPolylineCoordinates:line count:2 bufferDistance:0];
+
+    NSUInteger expected[] = {0, 0, 1, 0, 1, 1, 2, 1};
+    XCTAssertEqual(codes.count, 4);
+    XCTAssertEqualObjects([NSSet setWithArray:codes], [self tileCodesWithZoom:3 pairs:expected count:4]);
+}
+
+- (void)testConcavePolygonScanlinesSkipNotch {
+    CLLocationCoordinate2D polygon[] = {
+        [self coordinateAtTileX:0.5 y:0.5 zoom:3],
+        [self coordinateAtTileX:5.5 y:0.5 zoom:3],
+        [self coordinateAtTileX:5.5 y:2.5 zoom:3],
+        [self coordinateAtTileX:2.5 y:2.5 zoom:3],
+        [self coordinateAtTileX:2.5 y:5.5 zoom:3],
+        [self coordinateAtTileX:0.5 y:5.5 zoom:3],
+    };
+    NSArray *codes = [_manager tileCodesWithZoom:3 coveringPolygonCoordinates:polygon count:6];
+
+    NSMutableSet *expected = [NSMutableSet set];
+    for (NSUInteger y = 0; y <= 5; y++) {
+        for (NSUInteger x = 0; x <= (y <= 2 ? 5 : 2); x++) {
+            [expected addObject:[_manager tileCodeWithZoom:3 x:x y:y]];
+        }
+    }
+    XCTAssertEqual(codes.count, 27);
+    XCTAssertEqualObjects([NSSet setWithArray:codes], expected);
+}
+
+- (void)testPyramidAndQuadtreeCoverage {
+    CLLocationCoordinate2D square[] = {
+        [self coordinateAtTileX:1.5 y:1.5 zoom:3],
+        [self coordinateAtTileX:2.5 y:1.5 zoom:3],
+        [self coordinateAtTileX:2.5 y:2.5 zoom:3],
+        [self coordinateAtTileX:1.5 y:2.5 zoom:3],
+    };
+    NSArray *pyramid = [_manager tileCodesFromZoom:2 toZoom:3 coverage:ACTileCoveragePyramid coveringPolygonCoordinates:square count:4];
+
+    NSUInteger level3[] = {1, 1, 2, 1, 1, 2, 2, 2};
+    NSUInteger level2[] = {0, 0, 1, 0, 0, 1, 1, 1};
+    NSMutableSet *expected = [self tileCodesWithZoom:3 pairs:level3 count:4].mutableCopy;
+    [expected unionSet:[self tileCodesWithZoom:2 pairs:level2 count:4]];
+    XCTAssertEqual(pyramid.count, 8);
+    XCTAssertEqualObjects([NSSet setWithArray:pyramid], expected);
+
+    // four children of 1/1/2 merge, the half covered column of 2/1/2 stays at zoom 3
+    CLLocationCoordinate2D rect[] = {
+        [self coordinateAtTileX:2.2 y:2.2 zoom:3],
+        [self coordinateAtTileX:4.8 y:2.2 zoom:3],
+        [self coordinateAtTileX:4.8 y:3.8 zoom:3],
+        [self coordinateAtTileX:2.2 y:3.8 zoom:3],
+    };
+    NSArray *quadtree = [_manager tileCodesFromZoom:2 toZoom:3 coverage:ACTileCoverageQuadtree coveringPolygonCoordinates:rect count:4];
+    XCTAssertEqualObjects([NSSet setWithArray:quadtree], ([NSSet setWithArray:@[[_manager tileCodeWithZoom:2 x:1 y:1],
+                                                                               [_manager tileCodeWithZoom:3 x:4 y:2],
+                                                                               [_manager tileCodeWithZoom:3 x:4 y:3]]]));
+}
+
+- (void)testWorldEdgeStaysOnLastTileAtMaximumZoom {
+    NSUInteger zoom = ACTileKeyMaximumZoom;
+    CLLocationCoordinate2D edge = CLLocationCoordinate2DMake(-0.001, 180);
+    NSArray *codes = [_manager tileCodesWithZoom:zoom coveringPolylineCoordinates:&edge count:1 bufferDistance:0];
+
+    NSUInteger y = (NSUInteger)floor([_manager tilePointWithZoom:zoom atCoordinate:edge].y);
+    XCTAssertEqualObjects(codes, @[[_manager tileCodeWithZoom:zoom x:(1ULL << zoom) - 1 y:y]]);
+}
+
+- (void)testInvalidVertexCoversNothing {
+    CLLocationCoordinate2D polygon[] = {
+        [self coordinateAtTileX:1.5 y:1.5 zoom:3],
+        [self coordinateAtTileX:2.5 y:1.5 zoom:3],
+        kCLLocationCoordinate2DInvalid,
+    };
+    XCTAssertEqual([_manager tileCodesWithZoom:3 coveringPolygonCoordinates:polygon count:3].count, 0);
+    XCTAssertEqual([_manager tileCodesWithZoom:3 coveringPolylineCoordinates:polygon count:3 bufferDistance:10].count, 0);
+}
+
+@end
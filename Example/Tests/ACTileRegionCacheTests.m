@@ -0,0 +1,79 @@
+//
+//  ACTileRegionCacheTests.m
+//  ACSnippet_Tests
+//
+//  Created by Wenzhi WU on 19/10/2026.
+//  Copyright © 2026 Wenzhi WU. All rights reserved.
+//
+
+@import XCTest;
+#import <ACSnippet/ACTileManager.h>
+
+@interface ACTileRegionCacheTests : XCTestCase
+@property (nonatomic, strong) ACTileManager *manager;
+@end
+
+@implementation ACTileRegionCacheTests
+
+- (void)setUp {
+    [super setUp];
+    _manager = [[ACTileManager alloc] initWithHightDPITileImages:NO];
+}
+
+- (ACTileRegion *)regionWithX:(NSUInteger)x {
+    return [_manager tileWithZoom:4 x:x y:0];
+}
+
+- (void)testClockEvictionGivesReferencedRegionSecondChance {
+    ACTileRegionCache *cache = [[ACTileRegionCache alloc] initWithCapacity:3];
+    for (NSUInteger x = 0; x < 3; x++) {
+        [cache storeRegion:[self regionWithX:x] forKey:ACTileKeyMake(4, x, 0)];
+    }
+
+    // every slot is referenced, the hand clears all bits and takes the first slot
+    [cache storeRegion:[self regionWithX:3] forKey:ACTileKeyMake(4, 3, 0)];
+    XCTAssertEqual(cache.evictionCount, 1);
+
+    // tile 1 is referenced again, so tile 2 is replaced instead
+    XCTAssertNotNil([cache regionForKey:ACTileKeyMake(4, 1, 0)]);
+    [cache storeRegion:[self regionWithX:4] forKey:ACTileKeyMake(4, 4, 0)];
+    XCTAssertEqual(cache.evictionCount, 2);
+    XCTAssertEqual(cache.count, 3);
+    XCTAssertEqual(cache.allocationCount, 5);
+
+    XCTAssertNil([cache regionForKey:ACTileKeyMake(4, 0, 0)]);
+    XCTAssertNil([cache regionForKey:ACTileKeyMake(4, 2, 0)]);
+    XCTAssertNotNil([cache regionForKey:ACTileKeyMake(4, 1, 0)]);
+    XCTAssertNotNil([cache regionForKey:ACTileKeyMake(4, 3, 0)]);
+    XCTAssertNotNil([cache regionForKey:ACTileKeyMake(4, 4, 0)]);
+    XCTAssertEqual(cache.hitCount, 4);
+    XCTAssertEqual(cache.missCount, 2);
+    XCTAssertEqualWithAccuracy(cache.hitRate, 4.0 / 6.0, 0.0001);
+}
+
+- (void)testStoreReturnsSharedRegion {
+    ACTileRegionCache *cache = [[ACTileRegionCache alloc] initWithCapacity:4];
+    ACTileRegion *region = [self regionWithX:1];
+    XCTAssertEqual([cache storeRegion:region forKey:ACTileKeyMake(4, 1, 0)], region);
+    ACTileRegion *other = [[[ACTileManager alloc] initWithHightDPITileImages:NO] tileWithZoom:4 x:1 y:0];
+    XCTAssertNotEqual(other, region);
+    XCTAssertEqual([cache storeRegion:other forKey:ACTileKeyMake(4, 1, 0)], region);
+    XCTAssertEqual(cache.allocationCount, 1);
+}
+
+- (void)testTileCodeParsingIsStrict {
+    ACTileKey key = ACTileKeyFromTileCode(@"3/5/4");
+    XCTAssertEqual(ACTileKeyZoom(key), 4);
+    XCTAssertEqual(ACTileKeyX(key), 3);
+    XCTAssertEqual(ACTileKeyY(key), 5);
+
+    NSArray *malformed = @[@"", @"3/5", @"3/5/4/1", @"-3/5/4", @"3/-5/4", @"3/5/", @"/5/4", @"3//4",
+                           @"3 /5/4", @"+3/5/4", @"16/0/4", @"12345678901/0/4"];
+    for (NSString *code in malformed) {
+        XCTAssertEqual(ACTileKeyFromTileCode(code), ACTileKeyInvalid, @"%@", code);
+    }
+    XCTAssertEqual(ACTileKeyFromTileCode(nil), ACTileKeyInvalid);
+    XCTAssertNil([_manager tileWithTileCode:@"1/1/1/1"]);
+}
+
+@end
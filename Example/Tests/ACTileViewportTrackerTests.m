@@ -0,0 +1,145 @@
+//
+//  ACTileViewportTrackerTests.m
+//  ACSnippet_Tests
+//
+//  Created by Wenzhi WU on 19/10/2026.
+//  Copyright © 2026 Wenzhi WU. All rights reserved.
+//
+
+@import XCTest;
+#import <ACSnippet/ACTileViewportTracker.h>
+
+/// Zoom level of tracked tiles, tile rows stay at 512 just south of equator
+static const NSUInteger ACTrackerTestZoom = 10;
+
+@interface ACTileViewportTrackerTests : XCTestCase <ACTileViewportTrackerDelegate>
+@property (nonatomic, strong) ACTileManager *manager;
+@property (nonatomic, strong) ACTileViewportTracker *tracker;
+@property (nonatomic, strong) NSMutableArray <ACTileCollectionChanges *> *changes;
+@end
+
+@implementation ACTileViewportTrackerTests
+
+- (void)setUp {
+    [super setUp];
+    _manager = [[ACTileManager alloc] initWithHightDPITileImages:NO];
+    _tracker = [[ACTileViewportTracker alloc] initWithTileManager:_manager dimension:3];
+    _tracker.delegate = self;
+    _tracker.lookAheadInterval = 0;
+    _tracker.emitInterval = 0;
+    _changes = @[].mutableCopy;
+}
+
+- (void)viewportTracker:(ACTileViewportTracker *)tracker didChangeTiles:(ACTileCollectionChanges *)changes {
+    [_changes addObject:changes];
+}
+
+/// Coordinate at fractional tile x
+- (CLLocationCoordinate2D)coordinateAtTileX:(double)x {
+    return CLLocationCoordinate2DMake(-0.1, x / (1 << ACTrackerTestZoom) * 360.0 - 180.0);
+}
+
+- (void)updateAtTileX:(double)x timestamp:(NSTimeInterval)timestamp {
+    [_tracker updateWithZoom:ACTrackerTestZoom centerCoordinate:[self coordinateAtTileX:x] timestamp:timestamp];
+}
+
+/// Spin main run loop until condition holds or timeout
+- (BOOL)waitUntil:(BOOL (^)(void))condition timeout:(NSTimeInterval)timeout {
+    NSDate *deadline = [NSDate dateWithTimeIntervalSinceNow:timeout];
+    while (!condition()) {
+        if ([deadline timeIntervalSinceNow] <= 0) return NO;
+        [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.01]];
+    }
+
+    return YES;
+}
+
+- (NSSet <NSString *>*)tileCodesWithColumns:(NSRange)columns {
+    NSMutableSet *codes = [NSMutableSet set];
+    for (NSUInteger x = columns.location; x < NSMaxRange(columns); x++) {
+        for (NSUInteger y = 511; y <= 513; y++) {
+            [codes addObject:[_manager tileCodeWithZoom:ACTrackerTestZoom x:x y:y]];
+        }
+    }
+
+    return codes.copy;
+}
+
+- (void)testTilesEnterAndExitPastHysteresis {
+    [self updateAtTileX:100.5 timestamp:0];
+    XCTAssertTrue([self waitUntil:^BOOL{ return self.changes.count == 1; } timeout:2]);
+    XCTAssertEqualObjects([NSSet setWithArray:_changes[0].entered], [self tileCodesWithColumns:NSMakeRange(99, 3)]);
+
+    // column 99 is one tile off the viewport, hysteresis keeps it
+    [self updateAtTileX:101.5 timestamp:1];
+    XCTAssertTrue([self waitUntil:^BOOL{ return self.changes.count == 2; } timeout:2]);
+    XCTAssertEqualObjects([NSSet setWithArray:_changes[1].entered], [self tileCodesWithColumns:NSMakeRange(102, 1)]);
+    XCTAssertEqual(_changes[1].exited.count, 0);
+    XCTAssertEqual(_changes[1].remained.count, 9);
+
+    [self updateAtTileX:104.5 timestamp:2];
+    XCTAssertTrue([self waitUntil:^BOOL{ return self.changes.count == 3; } timeout:2]);
+    XCTAssertEqualObjects([NSSet setWithArray:_changes[2].entered], [self tileCodesWithColumns:NSMakeRange(103, 3)]);
+    XCTAssertEqualObjects([NSSet setWithArray:_changes[2].exited], [self tileCodesWithColumns:NSMakeRange(99, 3)]);
+    XCTAssertEqualObjects([NSSet setWithArray:_changes[2].remained], [self tileCodesWithColumns:NSMakeRange(102, 1)]);
+    XCTAssertEqualObjects(_tracker.trackedTileCodes, [self tileCodesWithColumns:NSMakeRange(102, 4)]);
+}
+
+- (void)testReplayIsThrottledOnTraceClock {
+    _tracker.emitInterval = 1;
+    [self updateAtTileX:100.5 timestamp:0];
+    [self updateAtTileX:101.5 timestamp:0.2];
+    [self updateAtTileX:102.5 timestamp:0.4];
+    [self updateAtTileX:103.5 timestamp:0.6];
+
+    // trace time has not passed the interval, so no wall clock timer may emit
+    XCTAssertTrue([self waitUntil:^BOOL{ return self.changes.count == 1; } timeout:2]);
+    XCTAssertFalse([self waitUntil:^BOOL{ return self.changes.count > 1; } timeout:1.2]);
+
+    [self updateAtTileX:104.5 timestamp:1.2];
+    XCTAssertTrue([self waitUntil:^BOOL{ return self.changes.count == 2; } timeout:2]);
+    XCTAssertEqualObjects([NSSet setWithArray:_changes[1].entered], [self tileCodesWithColumns:NSMakeRange(103, 3)]);
+
+    [self updateAtTileX:105.5 timestamp:1.3];
+    [_tracker flush];
+    XCTAssertTrue([self waitUntil:^BOOL{ return self.changes.count == 3; } timeout:2]);
+    XCTAssertEqualObjects([NSSet setWithArray:_changes[2].entered], [self tileCodesWithColumns:NSMakeRange(106, 1)]);
+}
+
+- (void)testLookAheadTracksTilesAheadOfMovingCamera {
+    _tracker.lookAheadInterval = 2;
+    [self updateAtTileX:100.5 timestamp:0];
+    XCTAssertTrue([self waitUntil:^BOOL{ return self.changes.count == 1; } timeout:2]);
+    XCTAssertEqualObjects([NSSet setWithArray:_changes[0].entered], [self tileCodesWithColumns:NSMakeRange(99, 3)]);
+
+    // 2 tiles per second smoothed to 1, look-ahead viewport centers 2 tiles ahead on column 104
+    [self updateAtTileX:102.5 timestamp:1];
+    XCTAssertTrue([self waitUntil:^BOOL{ return self.changes.count == 2; } timeout:2]);
+    XCTAssertEqualObjects([NSSet setWithArray:_changes[1].entered], [self tileCodesWithColumns:NSMakeRange(102, 4)]);
+    XCTAssertEqualObjects([NSSet setWithArray:_changes[1].exited], [self tileCodesWithColumns:NSMakeRange(99, 1)]);
+    XCTAssertEqualObjects(_tracker.trackedTileCodes, [self tileCodesWithColumns:NSMakeRange(100, 6)]);
+}
+
+- (void)testZoomBeyondMaximumIsIgnored {
+    [_tracker updateWithZoom:ACTileKeyMaximumZoom + 1 centerCoordinate:[self coordinateAtTileX:100.5] timestamp:0];
+    [_tracker flush];
+    XCTAssertFalse([self waitUntil:^BOOL{ return self.changes.count > 0; } timeout:0.5]);
+    XCTAssertEqual(_tracker.trackedTileCodes.count, 0);
+}
+
+- (void)testResetEmitsTrackedTilesAsExited {
+    [self updateAtTileX:100.5 timestamp:0];
+    XCTAssertTrue([self waitUntil:^BOOL{ return self.changes.count == 1; } timeout:2]);
+
+    [_tracker reset];
+    XCTAssertTrue([self waitUntil:^BOOL{ return self.changes.count == 2; } timeout:2]);
+    XCTAssertEqual(_changes[1].entered.count, 0);
+    XCTAssertEqualObjects([NSSet setWithArray:_changes[1].exited], [self tileCodesWithColumns:NSMakeRange(99, 3)]);
+    XCTAssertEqual(_tracker.trackedTileCodes.count, 0);
+
+    [self updateAtTileX:100.5 timestamp:1];
+    XCTAssertTrue([self waitUntil:^BOOL{ return self.changes.count == 3; } timeout:2]);
+    XCTAssertEqual(_changes[2].entered.count, 9);
+}
+
+@end
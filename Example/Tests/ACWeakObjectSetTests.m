@@ -0,0 +1,134 @@
+//
+//  ACWeakObjectSetTests.m
+//  ACSnippet_Tests
+//
+//  Created by Wenzhi WU on 19/10/2026.
+//  Copyright © 2026 Wenzhi WU. All rights reserved.
+//
+
+@import XCTest;
+#import <ACSnippet/ACWeakObjectSet.h>
+
+/// Observer that leaves its set on dealloc, the common weak observer pattern
+@interface ACSelfRemovingObserver : NSObject
+@property (nonatomic, weak) ACWeakObjectSet *set;
+@end
+
+@implementation ACSelfRemovingObserver
+
+- (void)dealloc {
+    [_set removeObject:self];
+}
+
+@end
+
+@interface ACWeakObjectSetTests : XCTestCase
+
+@end
+
+@implementation ACWeakObjectSetTests
+
+- (void)testAddRemoveContains {
+    ACWeakObjectSet *set = [ACWeakObjectSet new];
+    NSMutableArray *objects = @[].mutableCopy;
+    for (NSUInteger i = 0; i < 100; i++) {
+        NSObject *object = [NSObject new];
+        [objects addObject:object];
+        [set addObject:object];
+        [set addObject:object];
+    }
+
+    XCTAssertEqual(set.count, 100);
+    for (NSUInteger i = 0; i < 100; i += 2) {
+        [set removeObject:objects[i]];
+    }
+
+    for (NSUInteger i = 0; i < 100; i++) {
+        XCTAssertEqual([set containsObject:objects[i]], i % 2 == 1);
+    }
+    XCTAssertEqual(set.count, 50);
+    XCTAssertFalse([set containsObject:[NSObject new]]);
+}
+
+- (void)testDeallocatedObjectsAreSkippedAndCompacted {
+    ACWeakObjectSet *set = [ACWeakObjectSet new];
+    NSObject *survivor = [NSObject new];
+    [set addObject:survivor];
+    @autoreleasepool {
+        for (NSUInteger i = 0; i < 1000; i++) {
+            [set addObject:[NSObject new]];
+        }
+    }
+
+    __block NSUInteger enumerated = 0;
+    [set enumerateObjectsUsingBlock:^(id object, BOOL *stop) {
+        XCTAssertEqual(object, survivor);
+        enumerated++;
+    }];
+
+    XCTAssertEqual(enumerated, 1);
+    XCTAssertEqualObjects([set allObjects], @[survivor]);
+    XCTAssertTrue([set containsObject:survivor]);
+}
+
+- (void)testConcurrentReaders {
+    ACWeakObjectSet *set = [ACWeakObjectSet new];
+    NSMutableArray *objects = @[].mutableCopy;
+    for (NSUInteger i = 0; i < 64; i++) {
+        [objects addObject:[NSObject new]];
+        [set addObject:objects.lastObject];
+    }
+
+    dispatch_apply(10000, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^(size_t index) {
+        if (index % 100 == 0) {
+            NSObject *transient = [NSObject new];
+            [set addObject:transient];
+            [set removeObject:transient];
+        }
+        XCTAssertTrue([set containsObject:objects[index % objects.count]]);
+    });
+}
+
+- (void)testMutationDuringEnumeration {
+    ACWeakObjectSet *set = [ACWeakObjectSet new];
+    NSMutableArray *objects = @[].mutableCopy;
+    for (NSUInteger i = 0; i < 10; i++) {
+        NSObject *object = [NSObject new];
+        [objects addObject:object];
+        [set addObject:object];
+    }
+
+    NSObject *added = [NSObject new];
+    __block NSUInteger visited = 0;
+    [set enumerateObjectsUsingBlock:^(id object, BOOL *stop) {
+        [set removeObject:object];
+        [set addObject:added];
+        visited++;
+    }];
+
+    XCTAssertEqual(visited, 10);
+    XCTAssertEqual(set.count, 1);
+    XCTAssertTrue([set containsObject:added]);
+}
+
+- (void)testObserverReleasedDuringLookupDoesNotDeadlock {
+    ACWeakObjectSet *set = [ACWeakObjectSet new];
+    XCTestExpectation *finished = [self expectationWithDescription:@"finished"];
+    dispatch_async(dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^{
+        // readers race with the last release of each observer, whose dealloc takes the write lock
+        dispatch_apply(2000, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^(size_t index) {
+            ACSelfRemovingObserver *observer = [ACSelfRemovingObserver new];
+            observer.set = set;
+            [set addObject:observer];
+            dispatch_async(dispatch_get_global_queue(QOS_CLASS_DEFAULT, 0), ^{
+                [set containsObject:observer];
+                (void)set.count;
+            });
+        });
+        [finished fulfill];
+    });
+
+    [self waitForExpectationsWithTimeout:10 handler:nil];
+}
+
+@end